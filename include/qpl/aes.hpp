@@ -1,12 +1,14 @@
 #ifndef QPL_AES_HPP
 #define QPL_AES_HPP
 #pragma once
+#include <cstddef>
 #include <cstdlib>
 #include <memory>
 #include <vector>
 #include <string>
 
 #include <qpl/qpldeclspec.hpp>
+#include <qpl/span.hpp>
 #include <qpl/vardef.hpp>
 
 namespace qpl {
@@ -86,6 +88,19 @@ namespace qpl {
 			QPLDLL void set_key(const std::string& key);
 
 
+			//destination needs room for encrypted_size(size) bytes and may be the same memory as message
+			QPLDLL static qpl::size encrypted_size(qpl::size size);
+			QPLDLL void encrypt_blocks(const qpl::u8* message, qpl::size size, const std::string& key, qpl::u8* destination);
+			QPLDLL qpl::size decrypt_blocks(const qpl::u8* message, qpl::size size, const std::string& key, qpl::u8* destination, bool remove_null_terminations);
+			template<typename C>
+			void encrypt_blocks(qpl::span<const std::byte> message, const std::string& key, C& destination) {
+				this->encrypt_blocks(reinterpret_cast<const qpl::u8*>(message.data()), message.size(), key, reinterpret_cast<qpl::u8*>(destination.data()));
+			}
+			template<typename C>
+			qpl::size decrypt_blocks(qpl::span<const std::byte> message, const std::string& key, C& destination, bool remove_null_terminations) {
+				return this->decrypt_blocks(reinterpret_cast<const qpl::u8*>(message.data()), message.size(), key, reinterpret_cast<qpl::u8*>(destination.data()), remove_null_terminations);
+			}
+
 			QPLDLL void expand_key();
 			QPLDLL void cipher();
 			QPLDLL void decipher();
@@ -7,6 +7,7 @@
 #include <qpl/vardef.hpp>
 #include <qpl/span.hpp>
 #include <cmath>
+#include <array>
 #include <vector>
 #include <iostream>
 #include <numeric>
@@ -14,7 +15,12 @@
 #include <iterator>
 #include <iostream>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace qpl {
 
@@ -667,85 +673,390 @@ namespace qpl {
 		return { *(v.first), *(v.second) };
 	}
 
+	template<typename T>
+	struct min_max_result {
+		T min{};
+		T max{};
+		qpl::size min_index = qpl::size_max;
+		qpl::size max_index = qpl::size_max;
+	};
+
+	namespace detail {
+		//hardware_concurrency - 1 threads, started on first use and kept alive so repeated reductions don't spawn threads.
+		//run(n, task) calls task(0) ... task(n - 1) across the workers and the calling thread and returns once all are done.
+		//a second caller that finds the workers busy runs its tasks inline. tasks must not throw
+		class parallel_workers {
+		public:
+			static parallel_workers& get() {
+				static parallel_workers workers;
+				return workers;
+			}
+			qpl::size concurrency() const {
+				return this->m_threads.size() + 1;
+			}
+
+			template<typename F>
+			void run(qpl::size tasks, F&& task) {
+				std::unique_lock run_lock(this->m_run_mutex, std::try_to_lock);
+				if (!run_lock.owns_lock() || this->m_threads.empty() || tasks <= 1u) {
+					for (qpl::size t = 0u; t < tasks; ++t) {
+						task(t);
+					}
+					return;
+				}
+				std::function<void(qpl::size)> function = std::ref(task);
+				std::unique_lock lock(this->m_mutex);
+				this->m_task = &function;
+				this->m_next = 0u;
+				this->m_tasks = tasks;
+				this->m_remaining = tasks;
+				++this->m_generation;
+				this->m_start.notify_all();
+
+				this->work(lock);
+				this->m_done.wait(lock, [&]() {
+					return this->m_remaining == 0u;
+				});
+				this->m_task = nullptr;
+			}
+
+			~parallel_workers() {
+				{
+					std::lock_guard lock(this->m_mutex);
+					this->m_stop = true;
+				}
+				this->m_start.notify_all();
+				for (auto& thread : this->m_threads) {
+					thread.join();
+				}
+			}
+
+		private:
+			parallel_workers() {
+				auto count = qpl::max(std::thread::hardware_concurrency(), 1u) - 1u;
+				this->m_threads.reserve(count);
+				for (qpl::u32 i = 0u; i < count; ++i) {
+					this->m_threads.emplace_back([this]() {
+						std::unique_lock lock(this->m_mutex);
+						qpl::u64 seen = 0u;
+						while (true) {
+							this->m_start.wait(lock, [&]() {
+								return this->m_stop || this->m_generation != seen;
+							});
+							if (this->m_stop) {
+								return;
+							}
+							seen = this->m_generation;
+							this->work(lock);
+						}
+					});
+				}
+			}
+			parallel_workers(const parallel_workers&) = delete;
+			parallel_workers& operator=(const parallel_workers&) = delete;
+
+			//takes tasks until none are left. lock is held on entry and exit
+			void work(std::unique_lock<std::mutex>& lock) {
+				while (this->m_task && this->m_next < this->m_tasks) {
+					auto task = this->m_task;
+					auto t = this->m_next++;
+					lock.unlock();
+					(*task)(t);
+					lock.lock();
+					if (--this->m_remaining == 0u) {
+						this->m_done.notify_all();
+					}
+				}
+			}
+
+			std::mutex m_run_mutex;
+			std::mutex m_mutex;
+			std::condition_variable m_start;
+			std::condition_variable m_done;
+			const std::function<void(qpl::size)>* m_task = nullptr;
+			qpl::size m_next = 0u;
+			qpl::size m_tasks = 0u;
+			qpl::size m_remaining = 0u;
+			qpl::u64 m_generation = 0u;
+			bool m_stop = false;
+			std::vector<std::thread> m_threads;
+		};
+
+		constexpr qpl::size min_max_parallel_threshold = qpl::size{ 1u } << 20;
+
+		//smaller value wins, equal values go to the lower index
+		template<typename T>
+		void min_max_combine(qpl::min_max_result<T>& result, const qpl::min_max_result<T>& other) {
+			if (other.min < result.min || (!(result.min < other.min) && other.min_index < result.min_index)) {
+				result.min = other.min;
+				result.min_index = other.min_index;
+			}
+			if (result.max < other.max || (!(other.max < result.max) && other.max_index < result.max_index)) {
+				result.max = other.max;
+				result.max_index = other.max_index;
+			}
+		}
+
+		//reduces the elements data[i * stride] for i in [first, last). first < last
+		template<typename T, typename P>
+		auto min_max_reduce_range(qpl::span<T> data, qpl::size first, qpl::size last, qpl::size stride, P& projection) {
+			using value_type = std::decay_t<std::invoke_result_t<P&, T&>>;
+			qpl::min_max_result<value_type> result;
+			result.min = result.max = std::invoke(projection, data[first * stride]);
+			result.min_index = result.max_index = first * stride;
+
+			qpl::size i = first + 1;
+			if constexpr (std::is_arithmetic_v<value_type>) {
+				//independent lanes break the dependency chain, the branchless selects vectorize
+				constexpr qpl::size lanes = 8u;
+				std::array<value_type, lanes> min;
+				std::array<value_type, lanes> max;
+				std::array<qpl::size, lanes> min_index;
+				std::array<qpl::size, lanes> max_index;
+				min.fill(result.min);
+				max.fill(result.max);
+				min_index.fill(result.min_index);
+				max_index.fill(result.max_index);
+
+				for (; i + lanes <= last; i += lanes) {
+					for (qpl::size l = 0u; l < lanes; ++l) {
+						auto index = (i + l) * stride;
+						auto value = std::invoke(projection, data[index]);
+						bool less = value < min[l];
+						bool greater = max[l] < value;
+						min[l] = less ? value : min[l];
+						min_index[l] = less ? index : min_index[l];
+						max[l] = greater ? value : max[l];
+						max_index[l] = greater ? index : max_index[l];
+					}
+				}
+				for (qpl::size l = 0u; l < lanes; ++l) {
+					qpl::detail::min_max_combine(result, qpl::min_max_result<value_type>{ min[l], max[l], min_index[l], max_index[l] });
+				}
+			}
+			for (; i < last; ++i) {
+				auto index = i * stride;
+				auto value = std::invoke(projection, data[index]);
+				if (value < result.min) {
+					result.min = value;
+					result.min_index = index;
+				}
+				if (result.max < value) {
+					result.max = value;
+					result.max_index = index;
+				}
+			}
+			return result;
+		}
+	}
+
+	//min, max and the index of their first occurrence over data[0], data[stride], data[2 * stride], ...
+	//the elements are compared by projection(element), e.g. a member pointer like &data_point::data.
+	//big inputs are split across threads. an empty input returns value initialized values and qpl::size_max indices
+	template<typename T, typename P = std::identity>
+	auto min_max_reduce(qpl::span<T> data, qpl::size stride = 1u, P projection = {}) {
+		using value_type = std::decay_t<std::invoke_result_t<P&, T&>>;
+		stride = qpl::max(stride, qpl::size{ 1u });
+		auto count = (data.size() + stride - 1) / stride;
+		if (!count) {
+			return qpl::min_max_result<value_type>{};
+		}
+
+		qpl::size threads = 1u;
+		if (count >= qpl::detail::min_max_parallel_threshold) {
+			threads = qpl::min(qpl::detail::parallel_workers::get().concurrency(), count / (qpl::detail::min_max_parallel_threshold / 4));
+		}
+		if (threads <= 1u) {
+			return qpl::detail::min_max_reduce_range(data, 0u, count, stride, projection);
+		}
+
+		std::vector<qpl::min_max_result<value_type>> results(threads);
+		auto chunk = count / threads;
+		qpl::detail::parallel_workers::get().run(threads, [&](qpl::size t) {
+			auto last = t + 1 == threads ? count : (t + 1) * chunk;
+			results[t] = qpl::detail::min_max_reduce_range(data, t * chunk, last, stride, projection);
+		});
+		for (qpl::size t = 1u; t < threads; ++t) {
+			qpl::detail::min_max_combine(results[0], results[t]);
+		}
+		return results[0];
+	}
+	template<typename T, typename P = std::identity>
+	auto min_max_reduce(const std::vector<T>& data, qpl::size stride = 1u, P projection = {}) {
+		return qpl::min_max_reduce(qpl::span<const T>(data), stride, projection);
+	}
+
 	template<typename T>
 	std::pair<std::decay_t<T>, std::decay_t<T>> min_max_vector(const qpl::span<T>& data, qpl::u32 skip_size) {
 		if (data.empty()) {
 			return std::make_pair(std::decay_t<T>{}, std::decay_t<T>{});
 		}
-		std::decay_t<T> min = data.front();
-		std::decay_t<T> max = data.front();
-		for (int i = 0; i < data.size(); i += skip_size) {
-			min = qpl::min(min, data[i]);
-			max = qpl::min(max, data[i]);
-		}
-		return std::make_pair(min, max);
+		auto result = qpl::min_max_reduce(data, skip_size);
+		return std::make_pair(data[result.min_index], data[result.max_index]);
 	}
 
 
+	namespace detail {
+		//below this amount of comparisons a linear search beats building a lookup
+		constexpr qpl::size set_operation_linear_limit = 1024u;
+
+		//calls function(value, contained) for every value of compare, contained is whether target has an equal value.
+		//uses a hash set if T is hashable, a sorted copy of target if T is ordered, and std::find otherwise
+		template<typename T, typename F>
+		void for_each_membership(const std::vector<T>& target, const std::vector<T>& compare, F&& function) {
+			constexpr bool lookup = qpl::is_hashable<T>() || qpl::is_less_comparable<T>();
+			if (!lookup || target.size() * compare.size() <= set_operation_linear_limit) {
+				for (auto& i : compare) {
+					function(i, std::find(target.cbegin(), target.cend(), i) != target.cend());
+				}
+			}
+			else if constexpr (qpl::is_hashable<T>()) {
+				std::unordered_set<T> set(target.cbegin(), target.cend());
+				for (auto& i : compare) {
+					function(i, set.find(i) != set.cend());
+				}
+			}
+			else if constexpr (qpl::is_less_comparable<T>()) {
+				auto sorted = target;
+				std::sort(sorted.begin(), sorted.end());
+				for (auto& i : compare) {
+					function(i, std::binary_search(sorted.cbegin(), sorted.cend(), i));
+				}
+			}
+		}
+
+		//calls function(value, count) for every value of compare, count is the number of targets that have an equal value.
+		//each target is visited exactly once and only the distinct values of compare are stored
+		template<typename T, typename F>
+		void for_each_membership_count(const std::vector<std::vector<T>>& targets, const std::vector<T>& compare, F&& function) {
+			constexpr bool lookup = qpl::is_hashable<T>() || qpl::is_less_comparable<T>();
+			qpl::size target_size = 0u;
+			for (auto& target : targets) {
+				target_size += target.size();
+			}
+			struct counter {
+				qpl::size count = 0u;
+				qpl::size last_target = 0u;
+			};
+			auto count_target = [](counter& counter, qpl::size target) {
+				if (counter.last_target != target) {
+					counter.last_target = target;
+					++counter.count;
+				}
+			};
+
+			if (!lookup || target_size * compare.size() <= set_operation_linear_limit) {
+				for (auto& i : compare) {
+					qpl::size count = 0u;
+					for (auto& target : targets) {
+						if (std::find(target.cbegin(), target.cend(), i) != target.cend()) {
+							++count;
+						}
+					}
+					function(i, count);
+				}
+			}
+			else if constexpr (qpl::is_hashable<T>()) {
+				std::unordered_map<T, counter> counters;
+				counters.reserve(compare.size());
+				for (auto& i : compare) {
+					counters.try_emplace(i);
+				}
+				for (qpl::size t = 0u; t < targets.size(); ++t) {
+					for (auto& i : targets[t]) {
+						auto find = counters.find(i);
+						if (find != counters.end()) {
+							count_target(find->second, t + 1);
+						}
+					}
+				}
+				for (auto& i : compare) {
+					function(i, counters.find(i)->second.count);
+				}
+			}
+			else if constexpr (qpl::is_less_comparable<T>()) {
+				auto keys = compare;
+				std::sort(keys.begin(), keys.end());
+				keys.erase(std::unique(keys.begin(), keys.end(), [](const T& a, const T& b) {
+					return !(a < b) && !(b < a);
+				}), keys.end());
+				std::vector<counter> counters(keys.size());
+				for (qpl::size t = 0u; t < targets.size(); ++t) {
+					for (auto& i : targets[t]) {
+						auto find = std::lower_bound(keys.cbegin(), keys.cend(), i);
+						if (find != keys.cend() && !(i < *find)) {
+							count_target(counters[find - keys.cbegin()], t + 1);
+						}
+					}
+				}
+				for (auto& i : compare) {
+					function(i, counters[std::lower_bound(keys.cbegin(), keys.cend(), i) - keys.cbegin()].count);
+				}
+			}
+		}
+	}
+
+	//values of compare (in order) that are also in target
 	template<typename T>
 	std::vector<T> vector_including_values(const std::vector<T>& target, const std::vector<T>& compare) {
 		std::vector<T> result;
-		for (auto& i : compare) {
-			auto find = std::find(target.cbegin(), target.cend(), i);
-			if (find != target.cend()) {
-				result.push_back(*find);
+		qpl::detail::for_each_membership(target, compare, [&](const T& value, bool contained) {
+			if (contained) {
+				result.push_back(value);
 			}
-		}
-
+		});
 		return result;
 	}
+	//values of compare (in order) that are in every target
 	template<typename T>
 	std::vector<T> vector_including_values(const std::vector<std::vector<T>>& targets, const std::vector<T>& compare) {
-		auto sum = compare;
-		for (auto& i : targets) {
-			auto v = qpl::vector_including_values(i, compare);
-			sum = qpl::vector_including_values(v, sum);
-		}
-		return sum;
+		std::vector<T> result;
+		qpl::detail::for_each_membership_count(targets, compare, [&](const T& value, qpl::size count) {
+			if (count == targets.size()) {
+				result.push_back(value);
+			}
+		});
+		return result;
 	}
+	//values of compare (in order) that are not in target
 	template<typename T>
 	std::vector<T> vector_excluding_values(const std::vector<T>& target, const std::vector<T>& compare) {
 		std::vector<T> result;
-		for (auto& i : compare) {
-			auto find = std::find(target.cbegin(), target.cend(), i);
-			if (find == target.cend()) {
-				result.push_back(i);
+		qpl::detail::for_each_membership(target, compare, [&](const T& value, bool contained) {
+			if (!contained) {
+				result.push_back(value);
 			}
-		}
-
+		});
 		return result;
 	}
+	//values of compare (in order) that are in none of the targets
 	template<typename T>
 	std::vector<T> vector_excluding_values(const std::vector<std::vector<T>>& targets, const std::vector<T>& compare) {
-		auto sum = compare;
-		for (auto& i : targets) {
-			auto v = qpl::vector_excluding_values(i, compare);
-			sum = qpl::vector_including_values(v, sum);
-		}
-		return sum;
+		std::vector<T> result;
+		qpl::detail::for_each_membership_count(targets, compare, [&](const T& value, qpl::size count) {
+			if (!count) {
+				result.push_back(value);
+			}
+		});
+		return result;
 	}
 
 	template<typename T>
 	void vector_flip_x_axis(std::vector<std::vector<T>>& source) {
-		auto copy = source;
-		for (qpl::u32 y = 0u; y < copy.size(); ++y) {
-			for (qpl::u32 x = 0u; x < copy[0].size(); ++x) {
-				source[y][x] = copy[y][copy[0].size() - 1 - x];
-			}
+		for (auto& row : source) {
+			std::reverse(row.begin(), row.end());
 		}
 	}
 	template<typename T>
 	void vector_flip_y_axis(std::vector<std::vector<T>>& source) {
-		auto copy = source;
-		for (qpl::u32 y = 0u; y < copy.size(); ++y) {
-			for (qpl::u32 x = 0u; x < copy[0].size(); ++x) {
-				source[y][x] = copy[copy.size() - 1 - y][x];
-			}
-		}
+		std::reverse(source.begin(), source.end());
 	}
 
 	template<typename T>
-	std::vector<std::vector<T>> vector_rotate_right_copy(std::vector<std::vector<T>> source) {
+	std::vector<std::vector<T>> vector_rotate_right_copy(const std::vector<std::vector<T>>& source) {
+		if (source.empty()) {
+			return {};
+		}
 		std::vector<std::vector<T>> result(source[0].size(), std::vector<T>(source.size()));
 		for (qpl::u32 y = 0u; y < result.size(); ++y) {
 			for (qpl::u32 x = 0u; x < source.size(); ++x) {
@@ -759,24 +1070,31 @@ namespace qpl {
 		source = vector_rotate_right_copy(source);
 	}
 	template<typename T>
-	std::vector<std::vector<T>> vector_flip_x_axis_copy(std::vector<std::vector<T>> source) {
-		std::vector<std::vector<T>> result(source.size(), std::vector<T>(source[0].size()));
-		for (qpl::u32 y = 0u; y < source.size(); ++y) {
-			for (qpl::u32 x = 0u; x < source[0].size(); ++x) {
-				result[y][x] = source[y][source[0].size() - 1 - x];
+	std::vector<std::vector<T>> vector_rotate_left_copy(const std::vector<std::vector<T>>& source) {
+		if (source.empty()) {
+			return {};
+		}
+		std::vector<std::vector<T>> result(source[0].size(), std::vector<T>(source.size()));
+		for (qpl::u32 y = 0u; y < result.size(); ++y) {
+			for (qpl::u32 x = 0u; x < source.size(); ++x) {
+				result[y][x] = source[x][source[0].size() - 1 - y];
 			}
 		}
 		return result;
 	}
 	template<typename T>
+	void vector_rotate_left(std::vector<std::vector<T>>& source) {
+		source = vector_rotate_left_copy(source);
+	}
+	template<typename T>
+	std::vector<std::vector<T>> vector_flip_x_axis_copy(std::vector<std::vector<T>> source) {
+		vector_flip_x_axis(source);
+		return source;
+	}
+	template<typename T>
 	std::vector<std::vector<T>> vector_flip_y_axis_copy(std::vector<std::vector<T>> source) {
-		std::vector<std::vector<T>> result(source.size(), std::vector<T>(source[0].size()));
-		for (qpl::u32 y = 0u; y < source.size(); ++y) {
-			for (qpl::u32 x = 0u; x < source[0].size(); ++x) {
-				result[y][x] = source[source.size() - 1 - y][x];
-			}
-		}
-		return result;
+		vector_flip_y_axis(source);
+		return source;
 	}
 
 
@@ -852,42 +1170,86 @@ namespace qpl {
 	}
 
 
+	namespace detail {
+		//calls function(segment, first, last) for each range of output samples [first, last) that lies between point segment and segment + 1.
+		//sample i sits at i * step, the samples at or past the last point are passed with segment = points - 1
+		template<typename F>
+		void interpolation_segments(qpl::size points, qpl::size samples, qpl::f64 step, F&& function) {
+			qpl::size first = 0u;
+			for (qpl::size segment = 0u; segment + 1 < points && first < samples; ++segment) {
+				auto bound = static_cast<qpl::f64>(segment + 1);
+				auto last = qpl::min(samples, static_cast<qpl::size>(std::ceil(bound / step)));
+				while (last > first && (last - 1) * step >= bound) {
+					--last;
+				}
+				while (last < samples && last * step < bound) {
+					++last;
+				}
+				function(segment, first, last);
+				first = last;
+			}
+			if (first < samples) {
+				function(points - 1, first, samples);
+			}
+		}
+
+		//branch free loops over contiguous output, these vectorize for f32 and f64
+		template<typename T>
+		void linear_interpolation_kernel(T* result, qpl::size size, T delta, T step, T a, T b) {
+			auto difference = b - a;
+			for (qpl::size i = 0u; i < size; ++i) {
+				result[i] = a + difference * (delta + static_cast<T>(i) * step);
+			}
+		}
+		template<typename T>
+		void cubic_interpolation_kernel(T* result, qpl::size size, T delta, T step, T a, T b, T c, T d) {
+			auto c3 = d - c - a + b;
+			auto c2 = a * 2 - b * 2 - d + c;
+			auto c1 = c - a;
+			for (qpl::size i = 0u; i < size; ++i) {
+				auto t = delta + static_cast<T>(i) * step;
+				result[i] = ((c3 * t + c2) * t + c1) * t + b;
+			}
+		}
+	}
+
 	template<typename T>
 	std::vector<std::decay_t<T>> linear_vector_interpolation(qpl::span<T> data, qpl::size interpolations, qpl::size index_skip_size = 1u) {
+		using value_type = std::decay_t<T>;
 		if (data.empty()) {
 			return {};
 		}
 		if (data.size() == 1u) {
-			return std::vector<std::decay_t<T>>{ data[0] };
+			return std::vector<value_type>{ data[0] };
 		}
+		index_skip_size = qpl::max(index_skip_size, qpl::size{ 1u });
+		auto points = data.size() / index_skip_size;
 
-
-		std::vector<std::decay_t<T>> result(qpl::size_cast(data.size() / index_skip_size * interpolations));
+		std::vector<value_type> result(qpl::size_cast(points * interpolations));
 		if (result.size() == data.size()) {
 			for (qpl::u32 i = 0; i < result.size(); ++i) {
 				result[i] = data[i];
 			}
 			return result;
 		}
-
-		std::decay_t<T> a, b;
-
-		for (qpl::u32 i = 0u; i < result.size(); ++i) {
-			auto f = i / static_cast<qpl::f64>(result.size() - 1);
-
-			auto index = static_cast<qpl::u32>(f * (data.size() / index_skip_size - 1)) * index_skip_size;
-
-			a = b = data[index * index_skip_size];
-
-			if (index < data.size() / index_skip_size - 1) {
-				b = data[(index * index_skip_size) + 1];
-			}
-
-			auto left_over = ((data.size() / index_skip_size - 1) * f) - index;
-
-			result[i] = qpl::linear_interpolation(a, b, left_over);
+		if (points < 2u || result.size() < 2u) {
+			std::fill(result.begin(), result.end(), data[0]);
+			return result;
 		}
 
+		auto step = (points - 1) / static_cast<qpl::f64>(result.size() - 1);
+		qpl::detail::interpolation_segments(points, result.size(), step, [&](qpl::size segment, qpl::size first, qpl::size last) {
+			value_type a = data[segment * index_skip_size];
+			value_type b = segment + 1 < points ? data[(segment + 1) * index_skip_size] : a;
+			if constexpr (qpl::is_same<value_type, qpl::f32>() || qpl::is_same<value_type, qpl::f64>()) {
+				qpl::detail::linear_interpolation_kernel(result.data() + first, last - first, static_cast<value_type>(first * step - segment), static_cast<value_type>(step), a, b);
+			}
+			else {
+				for (qpl::size i = first; i < last; ++i) {
+					result[i] = qpl::linear_interpolation(a, b, i * step - segment);
+				}
+			}
+		});
 		return result;
 	}
 
@@ -926,47 +1288,37 @@ namespace qpl {
 
 	template<typename T>
 	std::vector<std::decay_t<T>> cubic_vector_interpolation(qpl::span<T> data, qpl::size interpolations, qpl::size index_skip_size = 1u) {
+		using value_type = std::decay_t<T>;
 		if (data.empty()) {
 			return {};
 		}
 		if (data.size() == 1u) {
-			return std::vector<std::decay_t<T>>{ data[0] };
+			return std::vector<value_type>{ data[0] };
 		}
-		std::vector<std::decay_t<T>> result(qpl::size_cast(data.size() / index_skip_size * interpolations));
+		index_skip_size = qpl::max(index_skip_size, qpl::size{ 1u });
+		auto points = data.size() / index_skip_size;
 
-		//if (result.size() == data.size()) {
-		//	for (qpl::u32 i = 0; i < result.size(); ++i) {
-		//		result[i] = data[i];
-		//	}
-		//	return result;
-		//}
-
-		std::decay_t<T> a, b, c, d;
-
-		for (qpl::u32 i = 0u; i < result.size(); ++i) {
-			auto f = i / static_cast<qpl::f64>(result.size() - 1);
-
-			auto index = static_cast<qpl::u32>(f * (data.size() / index_skip_size - 1));
-
-			c = a = b = data[index * index_skip_size];
-			if (index >= 1u) {
-				a = data[(index - 1) * index_skip_size];
-			}
+		std::vector<value_type> result(qpl::size_cast(points * interpolations));
+		if (points < 2u || result.size() < 2u) {
+			std::fill(result.begin(), result.end(), data[0]);
+			return result;
+		}
 
-			if (index < (data.size() - 1) / index_skip_size) {
-				c = data[(index + 1) * index_skip_size];
+		auto step = (points - 1) / static_cast<qpl::f64>(result.size() - 1);
+		qpl::detail::interpolation_segments(points, result.size(), step, [&](qpl::size segment, qpl::size first, qpl::size last) {
+			value_type b = data[segment * index_skip_size];
+			value_type a = segment >= 1u ? data[(segment - 1) * index_skip_size] : b;
+			value_type c = segment + 1 < points ? data[(segment + 1) * index_skip_size] : b;
+			value_type d = segment + 2 < points ? data[(segment + 2) * index_skip_size] : c;
+			if constexpr (qpl::is_same<value_type, qpl::f32>() || qpl::is_same<value_type, qpl::f64>()) {
+				qpl::detail::cubic_interpolation_kernel(result.data() + first, last - first, static_cast<value_type>(first * step - segment), static_cast<value_type>(step), a, b, c, d);
 			}
-			d = c;
-
-			if (index < (data.size() - 2) / index_skip_size) {
-				d = data[(index + 2) * index_skip_size];
+			else {
+				for (qpl::size i = first; i < last; ++i) {
+					result[i] = qpl::cubic_interpolation(a, b, c, d, i * step - segment);
+				}
 			}
-
-			auto left_over = ((data.size() / index_skip_size - 1) * f) - index;
-
-			result[i] = qpl::cubic_interpolation(a, b, c, d, left_over);
-		}
-
+		});
 		return result;
 	}
 
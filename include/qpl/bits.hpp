@@ -9,6 +9,13 @@
 #include <qpl/vardef.hpp>
 #include <qpl/memory.hpp>
 #include <array>
+#include <bit>
+#include <stdexcept>
+#include <vector>
+
+#if defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)
+#include <immintrin.h>
+#endif
 
 namespace qpl {
 	template<typename T, QPLCONCEPT(qpl::is_arithmetic<T>())>
@@ -85,6 +92,248 @@ namespace qpl {
 		qpl::default_type, qpl::floating_point<32u, bits>>;
 
 
+	namespace detail {
+		//word level kernels, shared by every bitset that is stored as an array of qpl::u64
+
+		constexpr qpl::size words_popcount(const qpl::u64* data, qpl::size size) {
+			qpl::size result = 0u;
+			qpl::size i = 0u;
+#if (defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)) && defined(__AVX2__)
+			if (!std::is_constant_evaluated() && size >= 16u) {
+				//nibble lookup popcount, 4 words per iteration
+				const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+				const __m256i low_mask = _mm256_set1_epi8(0x0f);
+				__m256i sum = _mm256_setzero_si256();
+				for (; i + 4u <= size; i += 4u) {
+					auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+					auto low = _mm256_and_si256(value, low_mask);
+					auto high = _mm256_and_si256(_mm256_srli_epi16(value, 4), low_mask);
+					auto count = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+					sum = _mm256_add_epi64(sum, _mm256_sad_epu8(count, _mm256_setzero_si256()));
+				}
+				result += static_cast<qpl::size>(_mm256_extract_epi64(sum, 0) + _mm256_extract_epi64(sum, 1) + _mm256_extract_epi64(sum, 2) + _mm256_extract_epi64(sum, 3));
+			}
+#endif
+			for (; i < size; ++i) {
+				result += std::popcount(data[i]);
+			}
+			return result;
+		}
+
+		//index of the n-th (0 based) set bit inside of word. word must have more than n set bits
+		constexpr qpl::size word_select(qpl::u64 word, qpl::size n) {
+#if (defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)) && defined(__BMI2__)
+			if (!std::is_constant_evaluated()) {
+				return std::countr_zero(_pdep_u64(qpl::u64{ 1 } << n, word));
+			}
+#endif
+			for (qpl::size i = 0u; i < n; ++i) {
+				word &= word - 1;
+			}
+			return std::countr_zero(word);
+		}
+
+		//first set bit at a position >= index, returns bits if there is none
+		constexpr qpl::size words_find_next(const qpl::u64* data, qpl::size size, qpl::size bits, qpl::size index) {
+			if (index >= bits) {
+				return bits;
+			}
+			auto w = index / 64u;
+			auto word = data[w] & (qpl::u64_max << (index % 64u));
+			while (true) {
+				if (word) {
+					auto result = w * 64u + std::countr_zero(word);
+					return result < bits ? result : bits;
+				}
+				if (++w >= size) {
+					return bits;
+				}
+				word = data[w];
+			}
+		}
+
+		//number of set bits in [0, index)
+		constexpr qpl::size words_rank(const qpl::u64* data, qpl::size index) {
+			auto result = qpl::detail::words_popcount(data, index / 64u);
+			if (index % 64u) {
+				result += std::popcount(data[index / 64u] & (qpl::u64_max >> (64u - index % 64u)));
+			}
+			return result;
+		}
+
+		//position of the n-th (0 based) set bit, returns bits if there is none
+		constexpr qpl::size words_select(const qpl::u64* data, qpl::size size, qpl::size bits, qpl::size n) {
+			for (qpl::size w = 0u; w < size; ++w) {
+				auto count = static_cast<qpl::size>(std::popcount(data[w]));
+				if (n < count) {
+					auto result = w * 64u + qpl::detail::word_select(data[w], n);
+					return result < bits ? result : bits;
+				}
+				n -= count;
+			}
+			return bits;
+		}
+
+		enum class word_operation {
+			bit_and, bit_or, bit_xor, bit_and_not
+		};
+
+		//destination[i] = destination[i] op source[i]
+		template<qpl::detail::word_operation operation>
+		constexpr void words_apply(qpl::u64* destination, const qpl::u64* source, qpl::size size) {
+			qpl::size i = 0u;
+#if (defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)) && defined(__AVX2__)
+			if (!std::is_constant_evaluated()) {
+				for (; i + 4u <= size; i += 4u) {
+					auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+					auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+					__m256i result;
+					if constexpr (operation == qpl::detail::word_operation::bit_and) {
+						result = _mm256_and_si256(a, b);
+					}
+					else if constexpr (operation == qpl::detail::word_operation::bit_or) {
+						result = _mm256_or_si256(a, b);
+					}
+					else if constexpr (operation == qpl::detail::word_operation::bit_xor) {
+						result = _mm256_xor_si256(a, b);
+					}
+					else {
+						result = _mm256_andnot_si256(b, a);
+					}
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), result);
+				}
+			}
+#endif
+			for (; i < size; ++i) {
+				if constexpr (operation == qpl::detail::word_operation::bit_and) {
+					destination[i] &= source[i];
+				}
+				else if constexpr (operation == qpl::detail::word_operation::bit_or) {
+					destination[i] |= source[i];
+				}
+				else if constexpr (operation == qpl::detail::word_operation::bit_xor) {
+					destination[i] ^= source[i];
+				}
+				else {
+					destination[i] &= ~source[i];
+				}
+			}
+		}
+
+		//moves bits towards higher indices, shifted in bits are 0
+		constexpr void words_shift_left(qpl::u64* data, qpl::size size, qpl::size shift) {
+			auto word_shift = shift / 64u;
+			auto bit_shift = shift % 64u;
+			for (qpl::size i = size; i-- > 0u;) {
+				qpl::u64 value = 0u;
+				if (i >= word_shift) {
+					value = data[i - word_shift] << bit_shift;
+					if (bit_shift && i > word_shift) {
+						value |= data[i - word_shift - 1] >> (64u - bit_shift);
+					}
+				}
+				data[i] = value;
+			}
+		}
+		//moves bits towards lower indices, shifted in bits are 0
+		constexpr void words_shift_right(qpl::u64* data, qpl::size size, qpl::size shift) {
+			auto word_shift = shift / 64u;
+			auto bit_shift = shift % 64u;
+			for (qpl::size i = 0u; i < size; ++i) {
+				qpl::u64 value = 0u;
+				if (i + word_shift < size) {
+					value = data[i + word_shift] >> bit_shift;
+					if (bit_shift && i + word_shift + 1 < size) {
+						value |= data[i + word_shift + 1] << (64u - bit_shift);
+					}
+				}
+				data[i] = value;
+			}
+		}
+
+		template<typename F>
+		constexpr void words_for_each_set_bit(const qpl::u64* data, qpl::size size, qpl::size bits, F&& function) {
+			for (qpl::size w = 0u; w < size; ++w) {
+				auto word = data[w];
+				while (word) {
+					auto index = w * 64u + std::countr_zero(word);
+					if (index >= bits) {
+						return;
+					}
+					function(index);
+					word &= word - 1;
+				}
+			}
+		}
+	}
+
+	//rank / select acceleration over a span of words. one absolute rank per superblock of 8 words (512 bits),
+	//so rank is a lookup plus at most 8 popcounts and select is a binary search plus at most 8 popcounts.
+	//the index refers to the words it was built from and has to be rebuilt after they are modified.
+	class rank_select_index {
+	public:
+		constexpr static qpl::size superblock_words = 8u;
+		constexpr static qpl::size superblock_bits = superblock_words * 64u;
+
+		rank_select_index() {
+
+		}
+		rank_select_index(qpl::span<const qpl::u64> words, qpl::size bits) {
+			this->build(words, bits);
+		}
+
+		void build(qpl::span<const qpl::u64> words, qpl::size bits) {
+			this->m_words = words;
+			this->m_bits = bits;
+			this->m_superblocks.resize((words.size() + superblock_words - 1) / superblock_words + 1);
+
+			qpl::size sum = 0u;
+			for (qpl::size i = 0u; i + 1 < this->m_superblocks.size(); ++i) {
+				this->m_superblocks[i] = sum;
+				auto begin = i * superblock_words;
+				auto end = qpl::min(begin + superblock_words, words.size());
+				sum += qpl::detail::words_popcount(words.data() + begin, end - begin);
+			}
+			this->m_superblocks.back() = sum;
+		}
+
+		qpl::size number_of_set_bits() const {
+			return this->m_superblocks.empty() ? qpl::size{} : this->m_superblocks.back();
+		}
+
+		//number of set bits in [0, index)
+		qpl::size rank(qpl::size index) const {
+			if (index >= this->m_bits) {
+				return this->number_of_set_bits();
+			}
+			auto superblock = index / superblock_bits;
+			auto begin = superblock * superblock_words;
+			auto result = this->m_superblocks[superblock];
+			result += qpl::detail::words_rank(this->m_words.data() + begin, index - begin * 64u);
+			return result;
+		}
+
+		//position of the n-th (0 based) set bit, returns the bit size if there is none
+		qpl::size select(qpl::size n) const {
+			if (n >= this->number_of_set_bits()) {
+				return this->m_bits;
+			}
+			auto it = std::upper_bound(this->m_superblocks.begin(), this->m_superblocks.end(), n);
+			auto superblock = static_cast<qpl::size>(std::distance(this->m_superblocks.begin(), it)) - 1;
+			n -= this->m_superblocks[superblock];
+
+			auto begin = superblock * superblock_words;
+			auto end = qpl::min(begin + superblock_words, this->m_words.size());
+			auto result = qpl::detail::words_select(this->m_words.data() + begin, end - begin, (end - begin) * 64u, n);
+			return qpl::min(begin * 64u + result, this->m_bits);
+		}
+
+	private:
+		qpl::span<const qpl::u64> m_words;
+		std::vector<qpl::size> m_superblocks;
+		qpl::size m_bits = 0u;
+	};
+
 	template<qpl::u64 bits, bool BOUNDARY_CHECK = detail::array_boundary_check>
 	class bitset {
 	public:
@@ -333,18 +582,72 @@ namespace qpl {
 			}
 			return qpl::approximate_multiple_up(bits, qpl::u64{ 64 }) / 64;
 		}
-		constexpr qpl::size number_of_set_bits() {
+		constexpr qpl::size number_of_set_bits() const {
 			if constexpr (is_array()) {
-				qpl::size size = 0u;
-				for (qpl::u32 i = 0u; i < this->data.size(); ++i) {
-					size += qpl::number_of_set_bits(this->data[i]);
-				}
-				return size;
+				return qpl::detail::words_popcount(this->data.data(), this->data.size());
+			}
+			else {
+				return std::popcount(qpl::u64_cast(this->data));
+			}
+		}
+
+		//first set bit, size() if there is none
+		constexpr qpl::size find_first() const {
+			return this->find_from(0u);
+		}
+		//first set bit after index, size() if there is none
+		constexpr qpl::size find_next(qpl::size index) const {
+			return this->find_from(index + 1);
+		}
+		//first set bit at index or after, size() if there is none
+		constexpr qpl::size find_from(qpl::size index) const {
+			if constexpr (is_array()) {
+				return qpl::detail::words_find_next(this->data.data(), this->data.size(), this->size(), index);
+			}
+			else {
+				auto word = qpl::u64_cast(this->data);
+				return qpl::detail::words_find_next(&word, 1u, this->size(), index);
+			}
+		}
+		//number of set bits in [0, index)
+		constexpr qpl::size rank(qpl::size index) const {
+			if (index >= this->size()) {
+				return this->number_of_set_bits();
+			}
+			if constexpr (is_array()) {
+				return qpl::detail::words_rank(this->data.data(), index);
+			}
+			else {
+				auto word = qpl::u64_cast(this->data);
+				return qpl::detail::words_rank(&word, index);
+			}
+		}
+		//position of the n-th (0 based) set bit, size() if there is none
+		constexpr qpl::size select(qpl::size n) const {
+			if constexpr (is_array()) {
+				return qpl::detail::words_select(this->data.data(), this->data.size(), this->size(), n);
+			}
+			else {
+				auto word = qpl::u64_cast(this->data);
+				return qpl::detail::words_select(&word, 1u, this->size(), n);
+			}
+		}
+		//calls function(index) for every set bit in ascending order
+		template<typename F>
+		constexpr void for_each_set_bit(F&& function) const {
+			if constexpr (is_array()) {
+				qpl::detail::words_for_each_set_bit(this->data.data(), this->data.size(), this->size(), function);
 			}
 			else {
-				return qpl::number_of_set_bits(this->data);
+				auto word = qpl::u64_cast(this->data);
+				qpl::detail::words_for_each_set_bit(&word, 1u, this->size(), function);
 			}
 		}
+		//for repeated rank / select queries on large bitsets. has to be rebuilt after the bitset is modified
+		qpl::rank_select_index make_rank_select_index() const {
+			static_assert(is_array(), "qpl::bitset::make_rank_select_index: only available for bitsets larger than 64 bits");
+			return qpl::rank_select_index(qpl::span<const qpl::u64>(this->data.data(), this->data.size()), this->size());
+		}
 
 		constexpr bitset() {
 			this->clear();
@@ -356,9 +659,7 @@ namespace qpl {
 
 		constexpr bitset& operator|=(const bitset& other) {
 			if constexpr (is_array()) {
-				for (qpl::u32 i = 0u; i < this->data.size(); ++i) {
-					this->data[i] |= other.data[i];
-				}
+				qpl::detail::words_apply<qpl::detail::word_operation::bit_or>(this->data.data(), other.data.data(), this->data.size());
 			}
 			else {
 				this->data |= other.data;
@@ -372,9 +673,7 @@ namespace qpl {
 
 		constexpr bitset& operator&=(const bitset& other) {
 			if constexpr (is_array()) {
-				for (qpl::u32 i = 0u; i < this->data.size(); ++i) {
-					this->data[i] &= other.data[i];
-				}
+				qpl::detail::words_apply<qpl::detail::word_operation::bit_and>(this->data.data(), other.data.data(), this->data.size());
 			}
 			else {
 				this->data &= other.data;
@@ -388,9 +687,7 @@ namespace qpl {
 
 		constexpr bitset& operator^=(const bitset& other) {
 			if constexpr (is_array()) {
-				for (qpl::u32 i = 0u; i < this->data.size(); ++i) {
-					this->data[i] ^= other.data[i];
-				}
+				qpl::detail::words_apply<qpl::detail::word_operation::bit_xor>(this->data.data(), other.data.data(), this->data.size());
 			}
 			else {
 				this->data ^= other.data;
@@ -419,7 +716,10 @@ namespace qpl {
 			else {
 				if constexpr (is_array()) {
 					for (auto& i : this->data) {
-						i = 1u;
+						i = qpl::u64_max;
+					}
+					if constexpr (bits % 64u) {
+						this->data[this->data.size() - 1] = qpl::u64_max >> (64u - bits % 64u);
 					}
 				}
 				else {
@@ -615,6 +915,231 @@ namespace qpl {
 		holding_type data;
 	};
 
+	//runtime sized bitset with 64 byte aligned word storage. bits past size() are always kept 0
+	class dynamic_bitset {
+	public:
+		using word_type = qpl::u64;
+		using allocator_type = qpl::aligned_allocator<word_type, 64u>;
+
+		dynamic_bitset() {
+
+		}
+		dynamic_bitset(qpl::size size, bool value = false) {
+			this->resize(size, value);
+		}
+
+		qpl::size size() const {
+			return this->m_size;
+		}
+		qpl::size word_size() const {
+			return this->m_words.size();
+		}
+		bool empty() const {
+			return this->m_size == 0u;
+		}
+		qpl::span<word_type> words() {
+			return qpl::span<word_type>(this->m_words.data(), this->m_words.size());
+		}
+		qpl::span<const word_type> words() const {
+			return qpl::span<const word_type>(this->m_words.data(), this->m_words.size());
+		}
+
+		void resize(qpl::size size, bool value = false) {
+			auto old_size = this->m_size;
+			this->m_words.resize((size + 63u) / 64u, value ? qpl::u64_max : qpl::u64{ 0 });
+			this->m_size = size;
+			if (value && size > old_size && old_size % 64u) {
+				this->m_words[old_size / 64u] |= qpl::u64_max << (old_size % 64u);
+			}
+			this->clear_unused_bits();
+		}
+		void reserve(qpl::size size) {
+			this->m_words.reserve((size + 63u) / 64u);
+		}
+		void push_back(bool value) {
+			if (this->m_size % 64u == 0u) {
+				this->m_words.push_back(0u);
+			}
+			++this->m_size;
+			this->set(this->m_size - 1, value);
+		}
+
+		//sets all bits to 0
+		void clear() {
+			std::fill(this->m_words.begin(), this->m_words.end(), qpl::u64{ 0 });
+		}
+		void fill(bool value) {
+			std::fill(this->m_words.begin(), this->m_words.end(), value ? qpl::u64_max : qpl::u64{ 0 });
+			this->clear_unused_bits();
+		}
+		void flip() {
+			for (auto& i : this->m_words) {
+				i = ~i;
+			}
+			this->clear_unused_bits();
+		}
+
+		bool get(qpl::size index) const {
+			return (this->m_words[index / 64u] >> (index % 64u)) & 0x1u;
+		}
+		void set(qpl::size index, bool value = true) {
+			auto mask = qpl::u64{ 1 } << (index % 64u);
+			if (value) {
+				this->m_words[index / 64u] |= mask;
+			}
+			else {
+				this->m_words[index / 64u] &= ~mask;
+			}
+		}
+		void reset(qpl::size index) {
+			this->m_words[index / 64u] &= ~(qpl::u64{ 1 } << (index % 64u));
+		}
+		void flip(qpl::size index) {
+			this->m_words[index / 64u] ^= qpl::u64{ 1 } << (index % 64u);
+		}
+		//sets the bit and returns its previous state - e.g. for visited sets
+		bool test_and_set(qpl::size index) {
+			auto& word = this->m_words[index / 64u];
+			auto mask = qpl::u64{ 1 } << (index % 64u);
+			bool result = word & mask;
+			word |= mask;
+			return result;
+		}
+		bool operator[](qpl::size index) const {
+			return this->get(index);
+		}
+
+		dynamic_bitset& operator&=(const dynamic_bitset& other) {
+			this->size_check(other, "&=");
+			qpl::detail::words_apply<qpl::detail::word_operation::bit_and>(this->m_words.data(), other.m_words.data(), this->m_words.size());
+			return *this;
+		}
+		dynamic_bitset& operator|=(const dynamic_bitset& other) {
+			this->size_check(other, "|=");
+			qpl::detail::words_apply<qpl::detail::word_operation::bit_or>(this->m_words.data(), other.m_words.data(), this->m_words.size());
+			return *this;
+		}
+		dynamic_bitset& operator^=(const dynamic_bitset& other) {
+			this->size_check(other, "^=");
+			qpl::detail::words_apply<qpl::detail::word_operation::bit_xor>(this->m_words.data(), other.m_words.data(), this->m_words.size());
+			return *this;
+		}
+		//removes all bits that are set in other
+		dynamic_bitset& and_not(const dynamic_bitset& other) {
+			this->size_check(other, "and_not");
+			qpl::detail::words_apply<qpl::detail::word_operation::bit_and_not>(this->m_words.data(), other.m_words.data(), this->m_words.size());
+			return *this;
+		}
+		dynamic_bitset& operator<<=(qpl::size shift) {
+			qpl::detail::words_shift_left(this->m_words.data(), this->m_words.size(), shift);
+			this->clear_unused_bits();
+			return *this;
+		}
+		dynamic_bitset& operator>>=(qpl::size shift) {
+			qpl::detail::words_shift_right(this->m_words.data(), this->m_words.size(), shift);
+			return *this;
+		}
+
+		dynamic_bitset operator&(const dynamic_bitset& other) const {
+			auto result = *this;
+			return result &= other;
+		}
+		dynamic_bitset operator|(const dynamic_bitset& other) const {
+			auto result = *this;
+			return result |= other;
+		}
+		dynamic_bitset operator^(const dynamic_bitset& other) const {
+			auto result = *this;
+			return result ^= other;
+		}
+		dynamic_bitset operator~() const {
+			auto result = *this;
+			result.flip();
+			return result;
+		}
+		dynamic_bitset operator<<(qpl::size shift) const {
+			auto result = *this;
+			return result <<= shift;
+		}
+		dynamic_bitset operator>>(qpl::size shift) const {
+			auto result = *this;
+			return result >>= shift;
+		}
+
+		bool operator==(const dynamic_bitset& other) const {
+			return this->m_size == other.m_size && std::equal(this->m_words.begin(), this->m_words.end(), other.m_words.begin());
+		}
+		bool operator!=(const dynamic_bitset& other) const {
+			return !(*this == other);
+		}
+
+		qpl::size number_of_set_bits() const {
+			return qpl::detail::words_popcount(this->m_words.data(), this->m_words.size());
+		}
+		bool any() const {
+			return std::any_of(this->m_words.begin(), this->m_words.end(), [](qpl::u64 word) { return word != 0u; });
+		}
+		bool none() const {
+			return !this->any();
+		}
+
+		//first set bit, size() if there is none
+		qpl::size find_first() const {
+			return this->find_from(0u);
+		}
+		//first set bit after index, size() if there is none
+		qpl::size find_next(qpl::size index) const {
+			return this->find_from(index + 1);
+		}
+		//first set bit at index or after, size() if there is none
+		qpl::size find_from(qpl::size index) const {
+			return qpl::detail::words_find_next(this->m_words.data(), this->m_words.size(), this->m_size, index);
+		}
+		//number of set bits in [0, index)
+		qpl::size rank(qpl::size index) const {
+			if (index >= this->m_size) {
+				return this->number_of_set_bits();
+			}
+			return qpl::detail::words_rank(this->m_words.data(), index);
+		}
+		//position of the n-th (0 based) set bit, size() if there is none
+		qpl::size select(qpl::size n) const {
+			return qpl::detail::words_select(this->m_words.data(), this->m_words.size(), this->m_size, n);
+		}
+		//calls function(index) for every set bit in ascending order
+		template<typename F>
+		void for_each_set_bit(F&& function) const {
+			qpl::detail::words_for_each_set_bit(this->m_words.data(), this->m_words.size(), this->m_size, function);
+		}
+		//for repeated rank / select queries. has to be rebuilt after the bitset is modified or resized
+		qpl::rank_select_index make_rank_select_index() const {
+			return qpl::rank_select_index(this->words(), this->m_size);
+		}
+
+		std::string string() const {
+			std::string result(this->m_size, '0');
+			this->for_each_set_bit([&](qpl::size index) {
+				result[this->m_size - 1 - index] = '1';
+			});
+			return result;
+		}
+
+	private:
+		void clear_unused_bits() {
+			if (this->m_size % 64u) {
+				this->m_words.back() &= qpl::u64_max >> (64u - this->m_size % 64u);
+			}
+		}
+		void size_check(const dynamic_bitset& other, const char* operation) const {
+			if (this->m_size != other.m_size) {
+				throw std::runtime_error(qpl::to_string("qpl::dynamic_bitset::", operation, " : sizes don't match (", this->m_size, " and ", other.m_size, ")").c_str());
+			}
+		}
+
+		std::vector<word_type, allocator_type> m_words;
+		qpl::size m_size = 0u;
+	};
+
 	struct double_content {
 		double_content() {
 
@@ -5,11 +5,20 @@
 #include <qpl/qpldeclspec.hpp>
 #include <qpl/vardef.hpp>
 #include <qpl/memory.hpp>
+#include <qpl/string.hpp>
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <functional>
 #include <regex>
 #include <fstream>
+#include <cstddef>
+#include <charconv>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace qpl {
 
@@ -248,6 +257,7 @@ namespace qpl {
         private:
             QPLDLL void construct();
             QPLDLL void check_update() const;
+            QPLDLL void apply_status(const std::filesystem::file_status& status) const;
 
             std::string m_string;
             mutable bool m_is_file;
@@ -256,6 +266,31 @@ namespace qpl {
             mutable bool m_update;
         };
 
+        struct transfer_progress {
+            qpl::size files_done = 0u;
+            qpl::size files_total = 0u;
+            qpl::u64 bytes_done = 0u;
+            qpl::u64 bytes_total = 0u;
+            qpl::f64 seconds = 0.0;
+
+            QPLDLL qpl::f64 bytes_per_second() const;
+        };
+        struct transfer_options {
+            bool overwrite = false;
+
+            //removes every source file once it has been copied
+            bool move = false;
+
+            //files in flight at the same time, 0 = std::thread::hardware_concurrency()
+            qpl::size queue_depth = 0u;
+
+            //per transfer, only used when the system can't copy the file by itself
+            qpl::size buffer_size = qpl::size{ 1 } << 20;
+
+            //called after every finished file, never concurrently
+            std::function<void(const qpl::filesys::transfer_progress&)> progress;
+        };
+
         class paths {
         public:
             paths() {
@@ -267,8 +302,12 @@ namespace qpl {
             paths(const qpl::filesys::paths& paths) {
                 *this = paths;
             }
+            paths(std::vector<qpl::filesys::path>&& paths) {
+                *this = std::move(paths);
+            }
 
             QPLDLL paths& operator=(const std::vector<qpl::filesys::path>& paths);
+            QPLDLL paths& operator=(std::vector<qpl::filesys::path>&& paths);
             QPLDLL paths& operator=(const qpl::filesys::paths& paths);
 
             QPLDLL std::vector<qpl::filesys::path>::iterator begin();
@@ -291,6 +330,10 @@ namespace qpl {
             QPLDLL void copy_overwrite_files_to(qpl::filesys::path destination);
             QPLDLL void move_overwrite_files_to(qpl::filesys::path destination);
             
+            QPLDLL qpl::filesys::transfer_progress transfer_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options);
+            QPLDLL qpl::filesys::transfer_progress transfer_files_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options);
+            QPLDLL qpl::filesys::transfer_progress transfer_as_tree_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options);
+
             QPLDLL void copy_as_tree_to(qpl::filesys::path destination);
             QPLDLL void move_as_tree_to(qpl::filesys::path destination);
             QPLDLL void copy_overwrite_as_tree_to(qpl::filesys::path destination);
@@ -490,8 +533,283 @@ namespace qpl {
 
         QPLDLL std::ostream& operator<<(std::ostream& os, const qpl::filesys::path& path);
 
+        struct walk_options {
+            //0 = std::thread::hardware_concurrency()
+            qpl::size threads = 0u;
+
+            //true: same order as std::filesystem::recursive_directory_iterator, false: grouped per directory in any order
+            bool ordered = true;
+
+            //called (concurrently) for directories that can't be read, the walk then skips them.
+            //if empty, walk throws std::filesystem::filesystem_error like recursive_directory_iterator
+            std::function<void(const qpl::filesys::path&, const std::error_code&)> on_error;
+        };
+
+        //recursively lists everything below root. starts on the calling thread and only adds threads
+        //(up to options.threads) while directories are waiting to be scanned. predicate is called concurrently
+        QPLDLL qpl::filesys::paths walk(const qpl::filesys::path& root, const std::function<bool(const qpl::filesys::path&)>& predicate = {}, const qpl::filesys::walk_options& options = {});
+
+        //composable search, e.g. query().extension_in({ "png", "jpg" }).name_contains("ui").size_greater(1'000'000)
+        //every condition is prepared once when added and the conditions are tested cheapest first
+        class query {
+        public:
+            QPLDLL query& ignore_case(bool enable = true);
+            QPLDLL query& files_only();
+            QPLDLL query& directories_only();
+
+            QPLDLL query& extension_equals(const qpl::string_view& extension);
+            QPLDLL query& extension_in(std::initializer_list<qpl::string_view> extensions);
+            QPLDLL query& extension_contains(const qpl::string_view& str);
+            QPLDLL query& extension_matches(const std::string& regex);
+            QPLDLL query& extension_doesnt_equal(const qpl::string_view& extension);
+            QPLDLL query& extension_not_in(std::initializer_list<qpl::string_view> extensions);
+            QPLDLL query& extension_doesnt_contain(const qpl::string_view& str);
+            QPLDLL query& extension_doesnt_match(const std::string& regex);
+
+            QPLDLL query& name_equals(const qpl::string_view& name);
+            QPLDLL query& name_in(std::initializer_list<qpl::string_view> names);
+            QPLDLL query& name_contains(const qpl::string_view& str);
+            QPLDLL query& name_matches(const std::string& regex);
+            QPLDLL query& name_doesnt_equal(const qpl::string_view& name);
+            QPLDLL query& name_not_in(std::initializer_list<qpl::string_view> names);
+            QPLDLL query& name_doesnt_contain(const qpl::string_view& str);
+            QPLDLL query& name_doesnt_match(const std::string& regex);
+
+            QPLDLL query& file_name_equals(const qpl::string_view& file_name);
+            QPLDLL query& file_name_in(std::initializer_list<qpl::string_view> file_names);
+            QPLDLL query& file_name_contains(const qpl::string_view& str);
+            QPLDLL query& file_name_matches(const std::string& regex);
+            QPLDLL query& file_name_doesnt_equal(const qpl::string_view& file_name);
+            QPLDLL query& file_name_not_in(std::initializer_list<qpl::string_view> file_names);
+            QPLDLL query& file_name_doesnt_contain(const qpl::string_view& str);
+            QPLDLL query& file_name_doesnt_match(const std::string& regex);
+
+            //sizes in bytes, only files can match
+            QPLDLL query& size_greater(qpl::u64 bytes);
+            QPLDLL query& size_less(qpl::u64 bytes);
+
+            QPLDLL query& where(const std::function<bool(const qpl::filesys::path&)>& check);
+
+            QPLDLL bool matches(const qpl::filesys::path& path) const;
+            QPLDLL qpl::filesys::paths search(const qpl::filesys::path& directory) const;
+            QPLDLL qpl::filesys::paths search_recursively(const qpl::filesys::path& directory, const qpl::filesys::walk_options& options = {}) const;
+
+        private:
+            enum class field : qpl::u8 {
+                extension, name, file_name, size, custom
+            };
+            enum class kind : qpl::u8 {
+                equals, contains, matches, greater, less
+            };
+            struct condition {
+                field target;
+                kind type;
+                bool negate;
+
+                //as passed by the user (for regex conditions the pattern), kept so ignore_case can prepare them again
+                std::vector<std::string> literals;
+                //literals with leading dots / slashes stripped and lowered for ignore_case
+                std::vector<std::string> prepared;
+                std::regex regex;
+                qpl::u64 bytes;
+                std::function<bool(const qpl::filesys::path&)> check;
+            };
+
+            QPLDLL query& add_literals(field target, kind type, bool negate, std::initializer_list<qpl::string_view> literals);
+            QPLDLL query& add_regex(field target, bool negate, const std::string& regex);
+            QPLDLL query& add(condition&& condition);
+
+            QPLDLL bool test(const condition& condition, const qpl::filesys::path& path) const;
+            QPLDLL void prepare(condition& condition) const;
+            QPLDLL static qpl::size cost(const condition& condition);
+
+            std::vector<condition> m_conditions;
+            bool m_ignore_case = false;
+            bool m_files_only = false;
+            bool m_directories_only = false;
+        };
+
+        //read-only view of a whole file, mapped into memory instead of read into a buffer.
+        //the file has to stay the same size while mapped: on posix, touching pages past a truncated end raises SIGBUS.
+        //use read_file for files other processes may shrink (e.g. logs that get rotated)
+        class mapped_file {
+        public:
+            mapped_file() {
+
+            }
+            mapped_file(const qpl::filesys::path& path) {
+                this->open(path);
+            }
+            ~mapped_file() {
+                this->close();
+            }
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+            QPLDLL mapped_file(mapped_file&& other) noexcept;
+            QPLDLL mapped_file& operator=(mapped_file&& other) noexcept;
+
+            //throws std::runtime_error if the file can't be opened or mapped
+            QPLDLL void open(const qpl::filesys::path& path);
+            QPLDLL void close();
+
+            QPLDLL bool is_open() const;
+            QPLDLL bool empty() const;
+            QPLDLL qpl::size size() const;
+            QPLDLL const char* data() const;
+            QPLDLL qpl::string_view view() const;
+            QPLDLL qpl::span<const std::byte> bytes() const;
+
+        private:
+            QPLDLL void steal(mapped_file& other);
+
+            const char* m_data = nullptr;
+            qpl::size m_size = 0u;
+            bool m_open = false;
+#ifdef _WIN32
+            void* m_file = nullptr;
+            void* m_mapping = nullptr;
+#else
+            int m_descriptor = -1;
+#endif
+        };
+
+        //keeps the file open and writes it in blocks, for frequent small writes (e.g. logs) where
+        //write_to_file would open and close the file every call. thread safe
+        class file_writer {
+        public:
+            file_writer() {
+
+            }
+            file_writer(const qpl::filesys::path& path, qpl::size buffer_size = qpl::size{ 1 } << 16, bool append = true) {
+                this->open(path, buffer_size, append);
+            }
+            ~file_writer() {
+                try {
+                    this->close();
+                }
+                catch (...) {
+
+                }
+            }
+            file_writer(const file_writer&) = delete;
+            file_writer& operator=(const file_writer&) = delete;
+
+            //throws std::runtime_error if the file can't be opened
+            QPLDLL void open(const qpl::filesys::path& path, qpl::size buffer_size = qpl::size{ 1 } << 16, bool append = true);
+            //throws std::runtime_error if the remaining buffer can't be written
+            QPLDLL void close();
+            QPLDLL bool is_open() const;
+
+            //write, writeln and flush throw std::runtime_error if the writer isn't open or a write failed,
+            //including an earlier one of the background thread
+            QPLDLL void flush();
+            //flushes from a background thread every `seconds` while the file is open, 0 stops the thread.
+            //the interval is kept across close() and open()
+            QPLDLL void set_flush_interval(double seconds);
+
+            QPLDLL qpl::size buffered() const;
+            QPLDLL qpl::size buffer_size() const;
+
+            template<typename... Args>
+            void write(const Args&... args) {
+                std::lock_guard lock(this->m_mutex);
+                this->check_writable();
+                (this->append(args), ...);
+            }
+            template<typename... Args>
+            void writeln(const Args&... args) {
+                std::lock_guard lock(this->m_mutex);
+                this->check_writable();
+                (this->append(args), ...);
+                this->append('\n');
+            }
+
+        private:
+            //formats straight into the buffer, same output as qpl::to_string
+            template<typename T>
+            void append(const T& value) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    this->append(value ? '1' : '0');
+                }
+                else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+                    if (this->m_used == this->m_buffer.size()) {
+                        this->write_buffer();
+                    }
+                    this->m_buffer[this->m_used++] = static_cast<char>(value);
+                }
+                else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+                    constexpr qpl::size max_digits = 32u;
+                    if (this->m_buffer.size() - this->m_used < max_digits) {
+                        this->write_buffer();
+                    }
+                    auto begin = this->m_buffer.data() + this->m_used;
+                    std::to_chars_result result;
+                    if constexpr (std::is_floating_point_v<T>) {
+                        result = std::to_chars(begin, begin + max_digits, value, std::chars_format::general, 6);
+                    }
+                    else {
+                        result = std::to_chars(begin, begin + max_digits, value);
+                    }
+                    this->m_used += static_cast<qpl::size>(result.ptr - begin);
+                }
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                    std::string_view view = value;
+                    this->append_bytes(view.data(), view.size());
+                }
+                else {
+                    auto string = qpl::to_string(value);
+                    this->append_bytes(string.data(), string.size());
+                }
+            }
+            QPLDLL void append_bytes(const char* data, qpl::size size);
+            QPLDLL void write_buffer();
+            QPLDLL void check_writable();
+            QPLDLL void close_file();
+            QPLDLL void start_thread();
+            QPLDLL void stop_thread();
+
+            std::ofstream m_file;
+            std::vector<char> m_buffer;
+            qpl::size m_used = 0u;
+            mutable std::mutex m_mutex;
+
+            //serializes open, close and set_flush_interval, which start and join m_thread
+            std::mutex m_thread_mutex;
+            std::thread m_thread;
+            std::condition_variable m_condition;
+            double m_interval = 0.0;
+            bool m_stop = false;
+
+            //set by the background thread, thrown by the next call
+            std::exception_ptr m_error;
+        };
+
         QPLDLL bool file_content_equals(const qpl::filesys::path& path1, const qpl::filesys::path& path2);
 
+        //64 bit xxHash of the file content, streamed in chunks
+        QPLDLL qpl::u64 file_content_hash(const qpl::filesys::path& path);
+
+        //remembers content hashes by path, a hash is recomputed once the file's size or last write time changes
+        class file_hash_cache {
+        public:
+            QPLDLL qpl::u64 hash(const qpl::filesys::path& path);
+            QPLDLL void erase(const qpl::filesys::path& path);
+            QPLDLL void clear();
+            QPLDLL qpl::size size() const;
+
+        private:
+            struct entry {
+                qpl::u64 size;
+                std::filesystem::file_time_type time;
+                qpl::u64 hash;
+            };
+            std::unordered_map<std::string, entry> m_entries;
+        };
+
+        //groups files with identical content: by size first, then by hash, each group is verified byte by byte
+        QPLDLL std::vector<qpl::filesys::paths> find_duplicates(const qpl::filesys::paths& files);
+        QPLDLL std::vector<qpl::filesys::paths> find_duplicates(const qpl::filesys::paths& files, qpl::filesys::file_hash_cache& cache);
+
         QPLDLL qpl::size file_lines(const qpl::filesys::path& path);
 
         QPLDLL qpl::size file_bytes(const qpl::filesys::path& path);
@@ -499,8 +817,84 @@ namespace qpl {
         QPLDLL std::vector<qpl::size> file_line_differences(const qpl::filesys::path& path1, const qpl::filesys::path& path2);
         QPLDLL qpl::f64 file_lines_difference_percentage(const qpl::filesys::path& path1, const qpl::filesys::path& path2);
 
+        struct split_options {
+            //per thread, the files are never held in memory as a whole
+            qpl::size buffer_size = qpl::size{ 1 } << 20;
+
+            //parts processed at the same time, 0 = std::thread::hardware_concurrency()
+            qpl::size threads = 1u;
+
+            //also compute the xxHash64 of every part
+            bool checksums = false;
+        };
+
+        //writes path.PART0, path.PART1, ... with up to bytes each. returns the part checksums if requested
         QPLDLL void split_file(const qpl::filesys::path& path, qpl::u32 bytes);
+        QPLDLL std::vector<qpl::u64> split_file(const qpl::filesys::path& path, qpl::u64 bytes, const qpl::filesys::split_options& options);
+
+        //concatenates the parts in order. returns the part checksums if requested, comparable with the ones of split_file
         QPLDLL void combine_files(const qpl::filesys::paths& paths, const qpl::filesys::path& destination);
+        QPLDLL std::vector<qpl::u64> combine_files(const qpl::filesys::paths& paths, const qpl::filesys::path& destination, const qpl::filesys::split_options& options);
+
+        struct snapshot_entry {
+            std::string path;
+            qpl::u64 size = 0u;
+
+            //platform ticks of the last write, only meaningful for comparisons
+            qpl::i64 time = 0;
+
+            //inode on POSIX, 0 on Windows
+            qpl::u64 id = 0u;
+            bool directory = false;
+        };
+        struct snapshot_diff {
+            std::vector<std::string> added;
+            std::vector<std::string> removed;
+            std::vector<std::string> modified;
+
+            QPLDLL bool empty() const;
+        };
+
+        //index of everything below a directory sorted by path, for cheap change detection between scans
+        class snapshot {
+        public:
+            QPLDLL static qpl::filesys::snapshot scan(const qpl::filesys::path& root, const qpl::filesys::walk_options& options = {});
+            QPLDLL static qpl::filesys::snapshot load(const qpl::filesys::path& file);
+            QPLDLL void save(const qpl::filesys::path& file) const;
+
+            //stats the given paths again and inserts, replaces or removes their entries. a removed directory takes its subtree with it
+            QPLDLL void update(const std::vector<std::string>& paths);
+
+            QPLDLL const qpl::filesys::snapshot_entry* find(const qpl::string_view& path) const;
+            QPLDLL const std::vector<qpl::filesys::snapshot_entry>& entries() const;
+            QPLDLL const std::string& root() const;
+            QPLDLL qpl::size size() const;
+            QPLDLL bool empty() const;
+
+        private:
+            std::string m_root;
+            std::vector<qpl::filesys::snapshot_entry> m_entries;
+        };
+
+        //directories only count as modified if they were replaced, not when their content changed
+        QPLDLL qpl::filesys::snapshot_diff diff(const qpl::filesys::snapshot& before, const qpl::filesys::snapshot& after);
+
+        //follows changes below the root of a snapshot and applies them on poll().
+        //ReadDirectoryChangesW on Windows, inotify on Linux, a rescan everywhere else
+        class snapshot_watcher {
+        public:
+            QPLDLL snapshot_watcher(const qpl::filesys::snapshot& snapshot);
+            QPLDLL ~snapshot_watcher();
+            snapshot_watcher(const snapshot_watcher&) = delete;
+            snapshot_watcher& operator=(const snapshot_watcher&) = delete;
+
+            //doesn't block. returns the paths that changed since the last poll
+            QPLDLL std::vector<std::string> poll(qpl::filesys::snapshot& snapshot);
+
+        private:
+            struct state;
+            std::unique_ptr<state> m_state;
+        };
 
         QPLDLL qpl::filesys::paths list_directory(const qpl::filesys::path& path);
         QPLDLL qpl::filesys::paths list_current_directory();
@@ -554,6 +948,16 @@ namespace qpl {
         QPLDLL void move(const qpl::filesys::path& path_source, const qpl::filesys::path& path_destination);
         QPLDLL void move_overwrite(const qpl::filesys::path& path_source, const qpl::filesys::path& path_destination);
 
+        struct transfer_job {
+            qpl::filesys::path source;
+
+            //full path of the target file
+            qpl::filesys::path destination;
+        };
+
+        //copies files in parallel, largest first. the first error is rethrown after the running transfers finished
+        QPLDLL qpl::filesys::transfer_progress transfer_files(const std::vector<qpl::filesys::transfer_job>& jobs, const qpl::filesys::transfer_options& options = {});
+
         QPLDLL void partially_rename_all(qpl::filesys::paths& files, const std::string& regex, const std::string& replace);
         QPLDLL void partially_rename_all(qpl::filesys::path& path, const std::string& regex, const std::string& replace);
         QPLDLL void copy_unpack_directory(const qpl::filesys::path& path);
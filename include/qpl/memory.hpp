@@ -9,19 +9,80 @@
 #include <qpl/type_traits.hpp>
 #include <qpl/system.hpp>
 #include <qpl/vardef.hpp>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
 
 
 
 namespace qpl {
+	//byte views of contiguous containers, no copies
+	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
+	constexpr qpl::span<const std::byte> as_bytes(const C& data) {
+		return qpl::span<const std::byte>(reinterpret_cast<const std::byte*>(data.data()), data.size() * sizeof(qpl::container_subtype<C>));
+	}
+	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
+	constexpr qpl::span<std::byte> as_writable_bytes(C& data) {
+		return qpl::span<std::byte>(reinterpret_cast<std::byte*>(data.data()), data.size() * sizeof(qpl::container_subtype<C>));
+	}
+
+	template<typename T>
+	bool is_aligned(const void* pointer) {
+		return reinterpret_cast<std::uintptr_t>(pointer) % alignof(T) == 0u;
+	}
+
+	namespace detail {
+		template<typename T>
+		void as_span_check(const void* pointer, qpl::size bytes) {
+			static_assert(std::is_trivially_copyable_v<T>, "qpl::as_span: T has to be trivially copyable");
+			if (!qpl::is_aligned<T>(pointer) || bytes % sizeof(T)) {
+				throw std::exception(qpl::to_string("qpl::as_span<", qpl::type_name<T>(), "> : ", bytes, " bytes are not ", alignof(T), "-aligned or not a multiple of ", sizeof(T)).c_str());
+			}
+		}
+	}
+
+	//reinterprets bytes as a span of T without copying. throws if the memory is misaligned for T or the size isn't a multiple of sizeof(T)
+	template<typename T>
+	qpl::span<const T> as_span(qpl::span<const std::byte> bytes) {
+		qpl::detail::as_span_check<T>(bytes.data(), bytes.size());
+		return qpl::span<const T>(reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T));
+	}
+	template<typename T>
+	qpl::span<T> as_span(qpl::span<std::byte> bytes) {
+		qpl::detail::as_span_check<T>(bytes.data(), bytes.size());
+		return qpl::span<T>(reinterpret_cast<T*>(bytes.data()), bytes.size() / sizeof(T));
+	}
+	template<typename T, typename C, QPLCONCEPT(qpl::is_container<C>())>
+	qpl::span<const T> as_span(const C& data) {
+		return qpl::as_span<T>(qpl::as_bytes(data));
+	}
+
+	//copies bytes into destination, reusing its capacity
+	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
+	void assign_memory(qpl::span<const std::byte> source, C& destination) {
+		destination.resize((source.size() + sizeof(qpl::container_subtype<C>) - 1) / sizeof(qpl::container_subtype<C>));
+		if (source.size()) {
+			memcpy(destination.data(), source.data(), source.size());
+		}
+	}
+	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
+	void append_memory(qpl::span<const std::byte> source, C& destination) {
+		auto size = destination.size();
+		destination.resize(size + (source.size() + sizeof(qpl::container_subtype<C>) - 1) / sizeof(qpl::container_subtype<C>));
+		if (source.size()) {
+			memcpy(destination.data() + size, source.data(), source.size());
+		}
+	}
+
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline C string_to_container_memory(const std::string& data) {
 		C result;
-		if (data.empty()) {
-			return C;
-		}
-		result.resize((data.size() - 1) / qpl::bytes_in_type<qpl::container_subtype<C>>() + 1);
-		memcpy(result.data(), data.data(), data.size());
+		qpl::assign_memory(qpl::as_bytes(data), result);
 		return result;
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
@@ -29,77 +90,63 @@ namespace qpl {
 		if (source.empty()) {
 			return;
 		}
-		dest.resize((source.size() - 1) / qpl::bytes_in_type<qpl::container_subtype<C>>() + 1);
-		memcpy(dest.data(), source.data(), source.size());
+		qpl::assign_memory(qpl::as_bytes(source), dest);
 	}
 
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline std::string container_memory_to_string(const C& data) {
 		std::string result;
-		result.resize(data.size() * sizeof(qpl::container_subtype<C>));
-		memcpy(result.data(), data.data(), result.size());
+		qpl::assign_memory(qpl::as_bytes(data), result);
 		return result;
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline void container_memory_to_string(const C& data, std::string& destination) {
-		destination.resize(data.size() * sizeof(qpl::container_subtype<C>));
-		memcpy(destination.data(), data.data(), destination.size());
+		qpl::assign_memory(qpl::as_bytes(data), destination);
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline void string_to_vector_memory(const std::string& data, C& destination) {
 		if (data.empty()) {
 			return;
 		}
-		destination.resize((data.size() - 1) / sizeof(qpl::container_subtype<C>) + 1);
-		memcpy(destination.data(), data.data(), data.size());
+		qpl::assign_memory(qpl::as_bytes(data), destination);
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline void string_to_vector_memory(const qpl::string_view& data, C& destination) {
 		if (data.empty()) {
 			return;
 		}
-		destination.resize((data.size() - 1) / sizeof(qpl::container_subtype<C>) + 1);
-		memcpy(destination.data(), data.data(), data.size());
+		qpl::assign_memory(qpl::as_bytes(data), destination);
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr inline void add_string_to_container_memory(const std::string& data, C& destination) {
-		if (data.empty()) {
-			return;
-		}
-		auto size = destination.size();
-		destination.resize(size + (data.size() - 1) / sizeof(qpl::container_subtype<C>) + 1);
-		memcpy(destination.data() + size, data.data(), data.size());
+		qpl::append_memory(qpl::as_bytes(data), destination);
 	}
 
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr std::wstring container_memory_to_wstring(const C& data) {
 		std::wstring result;
-		result.resize(data.size() * sizeof(qpl::container_subtype<C>) / (sizeof(wchar_t) / sizeof(char)));
-		memcpy(result.data(), data.data(), result.size() * (sizeof(wchar_t) / sizeof(char)));
+		result.resize(data.size() * sizeof(qpl::container_subtype<C>) / sizeof(wchar_t));
+		memcpy(result.data(), data.data(), result.size() * sizeof(wchar_t));
 		return result;
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr void container_memory_to_wstring(const C& data, std::wstring& destination) {
-		destination.resize(data.size() * sizeof(qpl::container_subtype<C>));
-		memcpy(destination.data(), data.data(), destination.size() * (sizeof(wchar_t) / sizeof(char)));
+		destination.resize(data.size() * sizeof(qpl::container_subtype<C>) / sizeof(wchar_t));
+		memcpy(destination.data(), data.data(), destination.size() * sizeof(wchar_t));
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr C wstring_to_container_memory(const std::wstring& data) {
 		C result;
-		result.resize(((data.size() * (sizeof(wchar_t) / sizeof(char)) - 1) / sizeof(qpl::container_subtype<C>) + 1));
-		memcpy(result.data(), data.data(), data.size() * (sizeof(wchar_t) / sizeof(char)));
+		qpl::assign_memory(qpl::as_bytes(data), result);
 		return result;
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr void wstring_to_container_memory(const std::wstring& data, C& destination) {
-		destination.resize(((data.size() * (sizeof(wchar_t) / sizeof(char)) - 1) / sizeof(qpl::container_subtype<C>) + 1));
-		memcpy(destination.data(), data.data(), data.size() * (sizeof(wchar_t) / sizeof(char)));
+		qpl::assign_memory(qpl::as_bytes(data), destination);
 	}
 	template<typename C, QPLCONCEPT(qpl::is_container<C>())>
 	constexpr void add_wstring_to_container_memory(const std::wstring& data, C& destination) {
-		auto size = destination.size();
-		destination.resize(size + ((data.size() * (sizeof(wchar_t) / sizeof(char)) - 1) / sizeof(qpl::container_subtype<C>)) + 1);
-		memcpy(destination.data() + size, data.data(), data.size() * (sizeof(wchar_t) / sizeof(char)));
+		qpl::append_memory(qpl::as_bytes(data), destination);
 	}
 
 	template<typename T, typename U, QPLCONCEPT(qpl::bytes_in_type<T>() == qpl::bytes_in_type<U>())>
@@ -155,6 +202,281 @@ namespace qpl {
 
 
 
+	template<typename T, qpl::size alignment>
+	struct aligned_allocator {
+		using value_type = T;
+
+		template<typename U>
+		struct rebind {
+			using other = aligned_allocator<U, alignment>;
+		};
+
+		constexpr aligned_allocator() noexcept {
+
+		}
+		template<typename U>
+		constexpr aligned_allocator(const aligned_allocator<U, alignment>&) noexcept {
+
+		}
+
+		T* allocate(qpl::size n) {
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignment }));
+		}
+		void deallocate(T* ptr, qpl::size) noexcept {
+			::operator delete(ptr, std::align_val_t{ alignment });
+		}
+
+		template<typename U>
+		constexpr bool operator==(const aligned_allocator<U, alignment>&) const noexcept {
+			return true;
+		}
+		template<typename U>
+		constexpr bool operator!=(const aligned_allocator<U, alignment>&) const noexcept {
+			return false;
+		}
+	};
+
+	//monotonic bump allocator. allocations are only given back all at once with reset() or by rewinding to a marker,
+	//deallocate() only reclaims the most recent allocation. a growing std::vector allocates its new buffer before
+	//freeing the old one, so its old buffers stay used until the next reset - reserve() up front where possible
+	class arena {
+	public:
+		struct marker {
+			qpl::size block;
+			qpl::size offset;
+		};
+
+		//rewinds the arena to where it was on construction
+		class scope {
+		public:
+			scope(qpl::arena& arena) : m_arena(arena), m_marker(arena.mark()) {
+
+			}
+			scope(const scope&) = delete;
+			scope& operator=(const scope&) = delete;
+			~scope() {
+				this->m_arena.rewind(this->m_marker);
+			}
+		private:
+			qpl::arena& m_arena;
+			qpl::arena::marker m_marker;
+		};
+
+		QPLDLL arena(qpl::size block_size = qpl::size{ 1u } << 16);
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+		QPLDLL ~arena();
+
+		QPLDLL void* allocate(qpl::size bytes, qpl::size alignment = alignof(std::max_align_t));
+		QPLDLL void deallocate(void* ptr, qpl::size bytes);
+
+		//keeps the blocks for reuse
+		QPLDLL void reset();
+		//gives the blocks back to the system
+		QPLDLL void release();
+		QPLDLL marker mark() const;
+		QPLDLL void rewind(marker marker);
+		scope make_scope() {
+			return scope(*this);
+		}
+
+		QPLDLL qpl::size used() const;
+		QPLDLL qpl::size capacity() const;
+		QPLDLL qpl::size allocations() const;
+
+	private:
+		struct block {
+			std::byte* memory;
+			qpl::size size;
+		};
+		std::vector<block> m_blocks;
+		qpl::size m_block_index = 0u;
+		qpl::size m_offset = 0u;
+		qpl::size m_block_size;
+		qpl::size m_allocations = 0u;
+	};
+
+	template<typename T>
+	struct arena_allocator {
+		using value_type = T;
+
+		template<typename U>
+		struct rebind {
+			using other = arena_allocator<U>;
+		};
+
+		constexpr arena_allocator(qpl::arena& arena) noexcept : arena(&arena) {
+
+		}
+		template<typename U>
+		constexpr arena_allocator(const arena_allocator<U>& other) noexcept : arena(other.arena) {
+
+		}
+
+		T* allocate(qpl::size n) {
+			return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T* ptr, qpl::size n) noexcept {
+			this->arena->deallocate(ptr, n * sizeof(T));
+		}
+
+		template<typename U>
+		constexpr bool operator==(const arena_allocator<U>& other) const noexcept {
+			return this->arena == other.arena;
+		}
+		template<typename U>
+		constexpr bool operator!=(const arena_allocator<U>& other) const noexcept {
+			return this->arena != other.arena;
+		}
+
+		qpl::arena* arena;
+	};
+
+	namespace detail {
+		//free lists for small sizes in steps of 16 bytes. larger or over-aligned requests go to the global heap
+		class pool_resource {
+		public:
+			constexpr static qpl::size granularity = 16u;
+			constexpr static qpl::size size_classes = 16u;
+			constexpr static qpl::size chunk_bytes = qpl::size{ 1u } << 14;
+
+			pool_resource() = default;
+			pool_resource(const pool_resource&) = delete;
+			pool_resource& operator=(const pool_resource&) = delete;
+			QPLDLL ~pool_resource();
+
+			QPLDLL void* allocate(qpl::size bytes, qpl::size alignment);
+			QPLDLL void deallocate(void* ptr, qpl::size bytes, qpl::size alignment);
+
+		private:
+			struct node {
+				node* next;
+			};
+			QPLDLL void grow(qpl::size size_class);
+
+			std::array<node*, size_classes> m_free{};
+			std::vector<void*> m_chunks;
+		};
+	}
+
+	//fixed size free list allocator for node based containers (std::list, std::map, ...).
+	//copies and rebinds share the same pool. not thread safe
+	template<typename T>
+	struct pool {
+		using value_type = T;
+
+		template<typename U>
+		struct rebind {
+			using other = pool<U>;
+		};
+
+		pool() : resource(std::make_shared<qpl::detail::pool_resource>()) {
+
+		}
+		template<typename U>
+		pool(const pool<U>& other) noexcept : resource(other.resource) {
+
+		}
+
+		T* allocate(qpl::size n) {
+			return static_cast<T*>(this->resource->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T* ptr, qpl::size n) noexcept {
+			this->resource->deallocate(ptr, n * sizeof(T), alignof(T));
+		}
+
+		template<typename U>
+		bool operator==(const pool<U>& other) const noexcept {
+			return this->resource == other.resource;
+		}
+		template<typename U>
+		bool operator!=(const pool<U>& other) const noexcept {
+			return this->resource != other.resource;
+		}
+
+		std::shared_ptr<qpl::detail::pool_resource> resource;
+	};
+
+	namespace detail {
+		//running total over everything ever added. differences of two totals give window sums.
+		//floating points use neumaier's compensated summation, integers wrap around in qpl::u64
+		template<typename T>
+		struct running_sum {
+			using value_type = qpl::conditional<qpl::if_true<qpl::is_floating_point<T>()>, qpl::f64, qpl::default_type, qpl::u64>;
+
+			void add(T value) {
+				if constexpr (qpl::is_floating_point<T>()) {
+					auto x = static_cast<qpl::f64>(value);
+					auto t = this->sum + x;
+					if (std::abs(this->sum) >= std::abs(x)) {
+						this->compensation += (this->sum - t) + x;
+					}
+					else {
+						this->compensation += (x - t) + this->sum;
+					}
+					this->sum = t;
+				}
+				else {
+					this->sum += static_cast<qpl::u64>(value);
+				}
+			}
+			T difference(const running_sum& before) const {
+				return static_cast<T>(this->wide_difference(before));
+			}
+			//the difference without narrowing to T: f64, i64 for signed and u64 for unsigned integers
+			auto wide_difference(const running_sum& before) const {
+				if constexpr (qpl::is_floating_point<T>()) {
+					return (this->sum - before.sum) + (this->compensation - before.compensation);
+				}
+				else if constexpr (qpl::is_signed<T>()) {
+					return static_cast<qpl::i64>(this->sum - before.sum);
+				}
+				else {
+					return this->sum - before.sum;
+				}
+			}
+
+			value_type sum = value_type{};
+			value_type compensation = value_type{};
+		};
+
+		//sliding window minimum (Compare = std::less) or maximum (Compare = std::greater).
+		//values are kept in Compare order, so the front is always the extreme of the window
+		template<typename T, typename Compare>
+		class monotonic_queue {
+		public:
+			void reset(qpl::size capacity) {
+				this->m_data.resize(capacity);
+				this->m_begin = 0u;
+				this->m_size = 0u;
+			}
+			void push(qpl::u64 sequence, const T& value) {
+				while (this->m_size && !Compare{}(this->m_data[(this->m_begin + this->m_size - 1) % this->m_data.size()].second, value)) {
+					--this->m_size;
+				}
+				this->m_data[(this->m_begin + this->m_size) % this->m_data.size()] = std::make_pair(sequence, value);
+				++this->m_size;
+			}
+			//removes everything added before sequence
+			void expire(qpl::u64 sequence) {
+				while (this->m_size && this->m_data[this->m_begin].first < sequence) {
+					this->m_begin = (this->m_begin + 1) % this->m_data.size();
+					--this->m_size;
+				}
+			}
+			bool empty() const {
+				return this->m_size == 0u;
+			}
+			const T& front() const {
+				return this->m_data[this->m_begin].second;
+			}
+		private:
+			std::vector<std::pair<qpl::u64, T>> m_data;
+			qpl::size m_begin = 0u;
+			qpl::size m_size = 0u;
+		};
+	}
+
 	template<typename T, qpl::size N = 0>
 	struct circular_array {
 
@@ -175,10 +497,37 @@ namespace qpl {
 			}
 			this->index = 0u;
 			this->rotation_finished = false;
+			this->reset_statistics();
 		}
 
+		//with statistics enabled, add() keeps a running sum and monotonic min / max queues
+		//so get_sum, get_average, get_min, get_max, get_min_max and get_sum_of_last_n are O(1).
+		//writing through operator[] bypasses add() and invalidates them until set_statistics(true) is called again.
+		void set_statistics(bool enabled) {
+			static_assert(qpl::is_stl_arithmetic<T>(), "qpl::circular_array::set_statistics: T has to be arithmetic");
+			this->statistics.enabled = enabled;
+			if (!enabled) {
+				return;
+			}
+			this->reset_statistics();
+
+			auto used = this->used_size();
+			auto oldest = this->rotation_finished ? this->index : qpl::size{ 0u };
+			for (qpl::size i = 0u; i < used; ++i) {
+				this->record_statistics(this->data[(oldest + i) % this->size()]);
+			}
+		}
+		bool statistics_enabled() const {
+			return this->statistics.enabled;
+		}
 
 		void add(T value) {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					this->record_statistics(value);
+				}
+			}
+
 			if (this->rotation_finished) {
 				this->data[this->index] = value;
 				++this->index;
@@ -200,6 +549,12 @@ namespace qpl {
 
 		template<typename R = qpl::conditional<qpl::if_true<qpl::is_floating_point<T>()>, T, qpl::f64>>
 		R get_average() const {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					//divide the wide window sum, get_sum() would wrap around for narrow T
+					return static_cast<R>(this->statistics.total.wide_difference(this->statistics.window_begin)) / this->used_size();
+				}
+			}
 			R sum = 0;
 			if (this->rotation_finished) {
 				for (auto& i : this->data) {
@@ -215,6 +570,11 @@ namespace qpl {
 			}
 		} 
 		T get_min() const {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					return this->statistics.min.empty() ? qpl::type_max<T>() : this->statistics.min.front();
+				}
+			}
 			T min = qpl::type_max<T>();
 			if (this->rotation_finished) {
 
@@ -236,6 +596,11 @@ namespace qpl {
 		}
 
 		T get_max() const {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					return this->statistics.max.empty() ? qpl::type_min<T>() : this->statistics.max.front();
+				}
+			}
 			T max = qpl::type_min<T>();
 			if (this->rotation_finished) {
 
@@ -256,6 +621,11 @@ namespace qpl {
 			}
 		}
 		T get_sum() const {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					return this->statistics.total.difference(this->statistics.window_begin);
+				}
+			}
 			T sum = 0;
 			if (this->rotation_finished) {
 				for (auto& i : this->data) {
@@ -270,33 +640,34 @@ namespace qpl {
 				return sum;
 			}
 		}
+		//sum of the last_n most recently added values
 		T get_sum_of_last_n(qpl::u32 last_n) const {
-			if (last_n == this->size()) {
+			auto used = this->used_size();
+			if (last_n >= used) {
 				return this->get_sum();
 			}
-			T sum = 0;
-			if (this->rotation_finished) {
-				qpl::u32 start = 0u;
-				if (last_n > (this->index - 1)) {
-					start = this->size() - 1 - (last_n - (this->index - 1));
-				}
-				else {
-					start = this->index - 1 - last_n;
-				}
-				for (qpl::u32 i = 0u; i < last_n; ++i) {
-					sum += this->data[(start + i) % this->size()];
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					if (last_n == 0u) {
+						return T{};
+					}
+					const auto& before = this->statistics.totals[(this->statistics.added - 1 - last_n) % this->size()];
+					return this->statistics.total.difference(before);
 				}
-				return sum;
 			}
-			else {
-				for (qpl::u32 i = this->index - 1 - last_n; i < this->index; ++i) {
-					sum += this->data[i];
-				}
-				return sum;
+			T sum = 0;
+			for (qpl::u32 i = 0u; i < last_n; ++i) {
+				sum += this->data[(this->index + this->size() - 1 - i) % this->size()];
 			}
+			return sum;
 		}
 
 		std::pair<T, T> get_min_max() const {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				if (this->statistics.enabled) {
+					return std::make_pair(this->get_min(), this->get_max());
+				}
+			}
 			std::pair<T, T> min_max = std::make_pair(qpl::type_max<T>(), qpl::type_min<T>());
 			if (this->rotation_finished) {
 
@@ -330,6 +701,7 @@ namespace qpl {
 				std::fill(this->data.begin(), this->data.end(), 0u);
 				this->index = 0u;
 				this->rotation_finished = false;
+				this->reset_statistics();
 			}
 		}
 
@@ -435,6 +807,381 @@ namespace qpl {
 		bool rotation_finished;
 		qpl::size index;
 		qpl::conditional<qpl::if_true<N == 0>, std::vector<T>, std::array<T, N>> data;
+
+	private:
+		struct statistics_state {
+			bool enabled = false;
+			qpl::u64 added = 0u;
+			qpl::detail::running_sum<T> total;
+			qpl::detail::running_sum<T> window_begin;
+			std::vector<qpl::detail::running_sum<T>> totals;
+			qpl::detail::monotonic_queue<T, std::less<T>> min;
+			qpl::detail::monotonic_queue<T, std::greater<T>> max;
+		};
+		struct empty_statistics_state {
+			bool enabled = false;
+		};
+
+		void reset_statistics() {
+			if constexpr (qpl::is_stl_arithmetic<T>()) {
+				this->statistics.added = 0u;
+				this->statistics.total = {};
+				this->statistics.window_begin = {};
+				if (this->statistics.enabled) {
+					this->statistics.totals.assign(this->size(), {});
+					this->statistics.min.reset(this->size());
+					this->statistics.max.reset(this->size());
+				}
+			}
+		}
+		void record_statistics(T value) {
+			if (this->size() == 0u) {
+				return;
+			}
+			auto& stats = this->statistics;
+			auto sequence = stats.added++;
+			auto& slot = stats.totals[sequence % this->size()];
+
+			//the slot still holds the total up to the value that drops out of the window
+			if (sequence >= this->size()) {
+				stats.window_begin = slot;
+			}
+			stats.total.add(value);
+			slot = stats.total;
+
+			auto first_valid = sequence + 1 > this->size() ? sequence + 1 - this->size() : qpl::u64{ 0u };
+			stats.min.expire(first_valid);
+			stats.max.expire(first_valid);
+			stats.min.push(sequence, value);
+			stats.max.push(sequence, value);
+		}
+
+		qpl::conditional<qpl::if_true<qpl::is_stl_arithmetic<T>()>, statistics_state, qpl::default_type, empty_statistics_state> statistics;
+	};
+
+	namespace detail {
+		constexpr qpl::size cache_line_size = 64u;
+
+		//asymmetric fence pair: heavy_barrier() (membarrier on linux, FlushProcessWriteBuffers on windows) runs a full fence
+		//on every thread of the process, so the hot side only needs light_barrier(), a compiler fence.
+		//without os support both fall back to a seq_cst fence
+		QPLDLL extern const bool heavy_barrier_supported;
+		QPLDLL void heavy_barrier();
+		inline void light_barrier() {
+			if (qpl::detail::heavy_barrier_supported) {
+				std::atomic_signal_fence(std::memory_order_seq_cst);
+			}
+			else {
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+			}
+		}
+
+		//spin-then-park wait. notify() only touches the futex when somebody is parked, the parking side pays for the barrier
+		class ring_waiter {
+		public:
+			template<typename F>
+			void wait(F&& ready) {
+				for (qpl::u32 i = 0u; i < 256u; ++i) {
+					if (ready()) {
+						return;
+					}
+					if (i >= 128u) {
+						std::this_thread::yield();
+					}
+				}
+				while (true) {
+					this->m_waiting.fetch_add(1u);
+					qpl::detail::heavy_barrier();
+					auto signal = this->m_signal.load();
+					if (ready()) {
+						this->m_waiting.fetch_sub(1u);
+						return;
+					}
+					this->m_signal.wait(signal);
+					this->m_waiting.fetch_sub(1u);
+				}
+			}
+			//call after publishing the change that makes ready() true
+			void notify() {
+				qpl::detail::light_barrier();
+				if (this->m_waiting.load(std::memory_order_relaxed)) {
+					this->m_signal.fetch_add(1u);
+					this->m_signal.notify_all();
+				}
+			}
+		private:
+			std::atomic<qpl::u32> m_signal = 0u;
+			std::atomic<qpl::u32> m_waiting = 0u;
+		};
+	}
+
+	//lock-free single producer / single consumer ring buffer. N has to be a power of two.
+	//unlike circular_array it never overwrites: push fails (or waits) while the ring is full
+	template<typename T, qpl::size N>
+	class spsc_ring {
+	public:
+		static_assert(N && (N & (N - 1)) == 0, "qpl::spsc_ring: N has to be a power of two");
+
+		constexpr static qpl::size capacity() {
+			return N;
+		}
+		//head first: it never passes tail, so the difference can't underflow. tail can move on meanwhile, hence the clamp
+		qpl::size size() const {
+			auto head = this->m_head.load(std::memory_order_acquire);
+			auto tail = this->m_tail.load(std::memory_order_acquire);
+			return std::min<qpl::size>(tail - head, N);
+		}
+		bool empty() const {
+			return this->size() == 0u;
+		}
+
+		//producer
+		bool push(const T& value) {
+			return this->push_impl(value);
+		}
+		bool push(T&& value) {
+			return this->push_impl(std::move(value));
+		}
+		//producer, returns how many of values were pushed
+		qpl::size push(qpl::span<const T> values) {
+			auto tail = this->m_tail.load(std::memory_order_relaxed);
+			auto free = N - (tail - this->m_cached_head);
+			if (free < values.size()) {
+				this->m_cached_head = this->m_head.load(std::memory_order_acquire);
+				free = N - (tail - this->m_cached_head);
+			}
+			auto count = qpl::min(free, values.size());
+			for (qpl::size i = 0u; i < count; ++i) {
+				this->m_data[(tail + i) & mask] = values[i];
+			}
+			if (count) {
+				this->m_tail.store(tail + count, std::memory_order_release);
+				this->m_not_empty.notify();
+			}
+			return count;
+		}
+		//producer, blocks while the ring is full
+		void wait_push(T value) {
+			while (!this->push_impl(std::move(value))) {
+				this->m_not_full.wait([&]() {
+					return this->m_tail.load(std::memory_order_relaxed) - this->m_head.load(std::memory_order_acquire) < N;
+				});
+			}
+		}
+
+		//consumer
+		bool pop(T& value) {
+			auto head = this->m_head.load(std::memory_order_relaxed);
+			if (head == this->m_cached_tail) {
+				this->m_cached_tail = this->m_tail.load(std::memory_order_acquire);
+				if (head == this->m_cached_tail) {
+					return false;
+				}
+			}
+			value = std::move(this->m_data[head & mask]);
+			this->m_head.store(head + 1, std::memory_order_release);
+			this->m_not_full.notify();
+			return true;
+		}
+		//consumer, returns how many values were written to the front of values
+		qpl::size pop(qpl::span<T> values) {
+			auto head = this->m_head.load(std::memory_order_relaxed);
+			if (this->m_cached_tail - head < values.size()) {
+				this->m_cached_tail = this->m_tail.load(std::memory_order_acquire);
+			}
+			auto count = qpl::min(this->m_cached_tail - head, values.size());
+			for (qpl::size i = 0u; i < count; ++i) {
+				values[i] = std::move(this->m_data[(head + i) & mask]);
+			}
+			if (count) {
+				this->m_head.store(head + count, std::memory_order_release);
+				this->m_not_full.notify();
+			}
+			return count;
+		}
+		//consumer, blocks while the ring is empty
+		T wait_pop() {
+			T value;
+			while (!this->pop(value)) {
+				this->m_not_empty.wait([&]() {
+					return this->m_tail.load(std::memory_order_acquire) != this->m_head.load(std::memory_order_relaxed);
+				});
+			}
+			return value;
+		}
+
+	private:
+		constexpr static qpl::size mask = N - 1;
+
+		template<typename U>
+		bool push_impl(U&& value) {
+			auto tail = this->m_tail.load(std::memory_order_relaxed);
+			if (tail - this->m_cached_head == N) {
+				this->m_cached_head = this->m_head.load(std::memory_order_acquire);
+				if (tail - this->m_cached_head == N) {
+					return false;
+				}
+			}
+			this->m_data[tail & mask] = std::forward<U>(value);
+			this->m_tail.store(tail + 1, std::memory_order_release);
+			this->m_not_empty.notify();
+			return true;
+		}
+
+		//consumer side
+		alignas(qpl::detail::cache_line_size) std::atomic<qpl::size> m_head = 0u;
+		qpl::size m_cached_tail = 0u;
+
+		//producer side
+		alignas(qpl::detail::cache_line_size) std::atomic<qpl::size> m_tail = 0u;
+		qpl::size m_cached_head = 0u;
+
+		//both sides read both waiters, so each gets its own line
+		alignas(qpl::detail::cache_line_size) qpl::detail::ring_waiter m_not_empty;
+		alignas(qpl::detail::cache_line_size) qpl::detail::ring_waiter m_not_full;
+
+		alignas(qpl::detail::cache_line_size) std::array<T, N> m_data;
+	};
+
+	//lock-free multi producer / single consumer ring buffer (per slot sequence numbers). N has to be a power of two
+	template<typename T, qpl::size N>
+	class mpsc_ring {
+	public:
+		static_assert(N && (N & (N - 1)) == 0, "qpl::mpsc_ring: N has to be a power of two");
+
+		mpsc_ring() {
+			for (qpl::size i = 0u; i < N; ++i) {
+				this->m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		constexpr static qpl::size capacity() {
+			return N;
+		}
+		//head first: it never passes tail, so the difference can't underflow. tail can move on meanwhile, hence the clamp
+		qpl::size size() const {
+			auto head = this->m_head.load(std::memory_order_acquire);
+			auto tail = this->m_tail.load(std::memory_order_acquire);
+			return std::min<qpl::size>(tail - head, N);
+		}
+		bool empty() const {
+			return this->size() == 0u;
+		}
+
+		//any thread
+		bool push(const T& value) {
+			return this->push_impl(value);
+		}
+		bool push(T&& value) {
+			return this->push_impl(std::move(value));
+		}
+		//any thread, returns how many of values were pushed. values of different producers may interleave
+		qpl::size push(qpl::span<const T> values) {
+			qpl::size count = 0u;
+			for (; count < values.size(); ++count) {
+				if (!this->push_impl(values[count], false)) {
+					break;
+				}
+			}
+			if (count) {
+				this->m_not_empty.notify();
+			}
+			return count;
+		}
+		//any thread, blocks while the ring is full
+		void wait_push(T value) {
+			while (!this->push_impl(std::move(value))) {
+				this->m_not_full.wait([&]() {
+					auto tail = this->m_tail.load(std::memory_order_relaxed);
+					return this->m_slots[tail & mask].sequence.load(std::memory_order_acquire) >= tail;
+				});
+			}
+		}
+
+		//consumer
+		bool pop(T& value) {
+			if (!this->pop_impl(value)) {
+				return false;
+			}
+			this->m_not_full.notify();
+			return true;
+		}
+		//consumer, returns how many values were written to the front of values
+		qpl::size pop(qpl::span<T> values) {
+			qpl::size count = 0u;
+			while (count < values.size() && this->pop_impl(values[count])) {
+				++count;
+			}
+			if (count) {
+				this->m_not_full.notify();
+			}
+			return count;
+		}
+		//consumer, blocks while the ring is empty
+		T wait_pop() {
+			T value;
+			while (!this->pop(value)) {
+				this->m_not_empty.wait([&]() {
+					auto head = this->m_head.load(std::memory_order_relaxed);
+					return this->m_slots[head & mask].sequence.load(std::memory_order_acquire) == head + 1;
+				});
+			}
+			return value;
+		}
+
+	private:
+		constexpr static qpl::size mask = N - 1;
+
+		template<typename U>
+		bool push_impl(U&& value, bool notify = true) {
+			auto tail = this->m_tail.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = this->m_slots[tail & mask];
+				auto sequence = slot.sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<qpl::i64>(sequence - tail);
+				if (difference == 0) {
+					if (this->m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+						slot.value = std::forward<U>(value);
+						slot.sequence.store(tail + 1, std::memory_order_release);
+						if (notify) {
+							this->m_not_empty.notify();
+						}
+						return true;
+					}
+				}
+				else if (difference < 0) {
+					return false;
+				}
+				else {
+					tail = this->m_tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+		bool pop_impl(T& value) {
+			auto head = this->m_head.load(std::memory_order_relaxed);
+			auto& slot = this->m_slots[head & mask];
+			if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+				return false;
+			}
+			value = std::move(slot.value);
+			slot.sequence.store(head + N, std::memory_order_release);
+			this->m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		struct slot_type {
+			std::atomic<qpl::size> sequence;
+			T value;
+		};
+
+		alignas(qpl::detail::cache_line_size) std::atomic<qpl::size> m_head = 0u;
+		alignas(qpl::detail::cache_line_size) std::atomic<qpl::size> m_tail = 0u;
+
+		//both sides read both waiters, so each gets its own line
+		alignas(qpl::detail::cache_line_size) qpl::detail::ring_waiter m_not_empty;
+		alignas(qpl::detail::cache_line_size) qpl::detail::ring_waiter m_not_full;
+
+		alignas(qpl::detail::cache_line_size) std::array<slot_type, N> m_slots;
 	};
 
 	namespace detail {
@@ -448,21 +1195,18 @@ namespace qpl {
 #else
 		constexpr bool vector_boundary_check = true;
 #endif
+		//the failure paths of the boundary checks live out of line so operator[] stays small enough to inline and vectorize
+		[[noreturn]] QPL_COLD QPLDLL void array_index_error(std::string(*type_name)(), qpl::size N, qpl::size index, bool at);
+		[[noreturn]] QPL_COLD QPLDLL void vector_index_error(std::string(*type_name)(), qpl::size size, qpl::size index, bool at);
+		[[noreturn]] QPL_COLD QPLDLL void vector_empty_error(std::string(*type_name)(), bool front);
 	}
 
 	template<typename T, qpl::size N, bool BOUNDARY_CHECK = detail::array_boundary_check>
 	struct array {
 	private:
 		constexpr void index_check(qpl::size index, bool at) const {
-			if (index >= this->size()) {
-				std::ostringstream stream;
-				stream << qpl::to_string("qpl::array<", qpl::type_name<T>(), ", ", N, ">", at ? ".at()" : "::operator[]", " : index is ", index);
-				qpl::i32 convert = qpl::i32_cast(index);
-				if (convert < 0) {
-					stream << qpl::to_string(" (= ", convert, ") ");
-				}
-				qpl::println(stream.str());
-				throw std::exception(stream.str().c_str());
+			if (index >= N) [[unlikely]] {
+				qpl::detail::array_index_error(&qpl::type_name<T>, N, index, at);
 			}
 		}
 
@@ -547,17 +1291,25 @@ namespace qpl {
 		}
 
 
-		constexpr T& front(qpl::size index) {
-			return this->memory.front(index);
+		//no boundary checks, for inner loops
+		constexpr qpl::span<T, N> unchecked() {
+			return qpl::span<T, N>(this->memory);
+		}
+		constexpr qpl::span<const T, N> unchecked() const {
+			return qpl::span<const T, N>(this->memory);
+		}
+
+		constexpr T& front() {
+			return this->memory.front();
 		}
-		constexpr const T& front(qpl::size index) const {
-			return this->memory.front(index);
+		constexpr const T& front() const {
+			return this->memory.front();
 		}
-		constexpr T& back(qpl::size index) {
-			return this->memory.back(index);
+		constexpr T& back() {
+			return this->memory.back();
 		}
-		constexpr const T& back(qpl::size index) const {
-			return this->memory.back(index);
+		constexpr const T& back() const {
+			return this->memory.back();
 		}
 
 		constexpr qpl::size size() const {
@@ -614,49 +1366,48 @@ namespace qpl {
 		return (os << array.string());
 	}
 
-	template<typename T, bool BOUNDARY_CHECK = detail::vector_boundary_check>
+	template<typename T, bool BOUNDARY_CHECK = detail::vector_boundary_check, typename Allocator = std::allocator<T>>
 	struct vector {
 
 	private:
 		constexpr void index_check(qpl::size index, bool at) const {
-			if (index >= this->size()) {
-				std::ostringstream stream;
-				stream << qpl::to_string("qpl::vector<", qpl::type_name<T>(), ">", at ? ".at()" : "::operator[]", " : index is ", index);
-				qpl::i32 convert = qpl::i32_cast(index);
-				if (convert < 0) {
-					stream << qpl::to_string(" (= ", convert, ") ");
-				}
-				stream << " - size of vector is " << this->size();
-				qpl::println(stream.str());
-				throw std::exception(stream.str().c_str());
+			if (index >= this->size()) [[unlikely]] {
+				qpl::detail::vector_index_error(&qpl::type_name<T>, this->size(), index, at);
 			}
 		}
 		constexpr void front_check(bool front) const {
-			if (this->empty()) {
-				std::ostringstream stream;
-				stream << qpl::to_string("qpl::vector<", qpl::type_name<T>(), ">", front ? ".front()" : ".back()", " : vector is empty");
-				qpl::println(stream.str());
-				throw std::exception(stream.str().c_str());
+			if (this->empty()) [[unlikely]] {
+				qpl::detail::vector_empty_error(&qpl::type_name<T>, front);
 			}
 		}
 	public:
 
-		using vector_type = std::vector<T>;
+		using vector_type = std::vector<T, Allocator>;
+		using allocator_type = Allocator;
 		vector_type memory;
 
 		constexpr vector() {
 
 		}
+		constexpr explicit vector(const Allocator& allocator) : memory(allocator) {
+
+		}
+
+		constexpr vector(const vector& other) : memory(other.memory, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.memory.get_allocator())) {
 
-		constexpr vector(const vector& other) : memory() {
-			*this = other;
 		}
 		constexpr vector(const std::vector<T>& other) : memory() {
 			*this = other;
 		}
+		constexpr vector(const std::vector<T>& other, const Allocator& allocator) : memory(allocator) {
+			*this = other;
+		}
 		constexpr vector(const std::initializer_list<T>& list) : memory() {
 			*this = list;
 		}
+		constexpr vector(const std::initializer_list<T>& list, const Allocator& allocator) : memory(allocator) {
+			*this = list;
+		}
 		template<typename First, typename... Args>
 		constexpr vector(First first, Args&&... args) : memory() {
 			auto result = qpl::type_cast<T>(first, args...);
@@ -670,7 +1421,7 @@ namespace qpl {
 			return *this;
 		}
 		constexpr vector& operator=(const std::vector<T>& other) {
-			this->memory = other;
+			this->memory.assign(other.begin(), other.end());
 			return *this;
 		}
 		constexpr vector& operator=(const std::initializer_list<T>& list) {
@@ -681,7 +1432,10 @@ namespace qpl {
 		}
 
 		constexpr operator std::vector<T>() {
-			return this->memory;
+			return std::vector<T>(this->memory.begin(), this->memory.end());
+		}
+		constexpr allocator_type get_allocator() const {
+			return this->memory.get_allocator();
 		}
 
 		constexpr void pop_back(const T& value) {
@@ -739,29 +1493,37 @@ namespace qpl {
 		}
 
 
-		constexpr T& front(qpl::size index) {
+		//no boundary checks, for inner loops
+		constexpr qpl::span<T> unchecked() {
+			return qpl::span<T>(this->memory);
+		}
+		constexpr qpl::span<const T> unchecked() const {
+			return qpl::span<const T>(this->memory);
+		}
+
+		constexpr T& front() {
 			if constexpr (BOUNDARY_CHECK) {
-				this->front_check(index, true);
+				this->front_check(true);
 			}
-			return this->memory.front(index);
+			return this->memory.front();
 		}
-		constexpr const T& front(qpl::size index) const {
+		constexpr const T& front() const {
 			if constexpr (BOUNDARY_CHECK) {
-				this->front_check(index, true);
+				this->front_check(true);
 			}
-			return this->memory.front(index);
+			return this->memory.front();
 		}
-		constexpr T& back(qpl::size index) {
+		constexpr T& back() {
 			if constexpr (BOUNDARY_CHECK) {
-				this->front_check(index, false);
+				this->front_check(false);
 			}
-			return this->memory.back(index);
+			return this->memory.back();
 		}
-		constexpr const T& back(qpl::size index) const {
+		constexpr const T& back() const {
 			if constexpr (BOUNDARY_CHECK) {
-				this->front_check(index, false);
+				this->front_check(false);
 			}
-			return this->memory.back(index);
+			return this->memory.back();
 		}
 
 		constexpr qpl::size size() const {
@@ -812,15 +1574,222 @@ namespace qpl {
 		std::string string() const {
 			return qpl::container_to_string(this->memory);
 		}
-		template<typename T>
-		friend std::ostream& operator<<(std::ostream& os, const vector<T>& array);
+		template<typename T, bool BOUNDARY_CHECK, typename Allocator>
+		friend std::ostream& operator<<(std::ostream& os, const vector<T, BOUNDARY_CHECK, Allocator>& array);
 	};
 
 
-	template<typename T>
-	std::ostream& operator<<(std::ostream& os, const vector<T>& array) {
+	template<typename T, bool BOUNDARY_CHECK, typename Allocator>
+	std::ostream& operator<<(std::ostream& os, const vector<T, BOUNDARY_CHECK, Allocator>& array) {
 		return (os << array.string());
 	}
+
+	//contiguous 2D storage, row-major in a single allocation. the transforms work in place, tile by tile
+	template<typename T>
+	class grid {
+	public:
+		//tiles of tile_size x tile_size elements fit comfortably into L1
+		constexpr static qpl::size tile_size = qpl::max(qpl::size{ 8u }, qpl::size{ 64u } / qpl::max(qpl::size{ 1u }, sizeof(T) / 8u));
+
+		grid() {
+
+		}
+		grid(qpl::size width, qpl::size height, const T& value = T{}) {
+			this->resize(width, height, value);
+		}
+		grid(const std::vector<std::vector<T>>& source) {
+			*this = source;
+		}
+
+		grid& operator=(const std::vector<std::vector<T>>& source) {
+			this->m_height = source.size();
+			this->m_width = source.empty() ? 0u : source.front().size();
+			this->m_data.resize(this->m_width * this->m_height);
+			for (qpl::size y = 0u; y < this->m_height; ++y) {
+				std::copy_n(source[y].cbegin(), qpl::min(this->m_width, source[y].size()), this->m_data.begin() + y * this->m_width);
+			}
+			return *this;
+		}
+		std::vector<std::vector<T>> to_vector() const {
+			std::vector<std::vector<T>> result(this->m_height);
+			for (qpl::size y = 0u; y < this->m_height; ++y) {
+				result[y].assign(this->m_data.cbegin() + y * this->m_width, this->m_data.cbegin() + (y + 1) * this->m_width);
+			}
+			return result;
+		}
+
+		void resize(qpl::size width, qpl::size height, const T& value = T{}) {
+			this->m_width = width;
+			this->m_height = height;
+			this->m_data.assign(width * height, value);
+		}
+		void fill(const T& value) {
+			std::fill(this->m_data.begin(), this->m_data.end(), value);
+		}
+		void clear() {
+			this->m_width = this->m_height = 0u;
+			this->m_data.clear();
+		}
+
+		qpl::size width() const {
+			return this->m_width;
+		}
+		qpl::size height() const {
+			return this->m_height;
+		}
+		qpl::size size() const {
+			return this->m_data.size();
+		}
+		bool empty() const {
+			return this->m_data.empty();
+		}
+
+		T& operator()(qpl::size x, qpl::size y) {
+			return this->m_data[y * this->m_width + x];
+		}
+		const T& operator()(qpl::size x, qpl::size y) const {
+			return this->m_data[y * this->m_width + x];
+		}
+		qpl::span<T> row(qpl::size y) {
+			return qpl::span<T>(this->m_data.data() + y * this->m_width, this->m_width);
+		}
+		qpl::span<const T> row(qpl::size y) const {
+			return qpl::span<const T>(this->m_data.data() + y * this->m_width, this->m_width);
+		}
+
+		T* data() {
+			return this->m_data.data();
+		}
+		const T* data() const {
+			return this->m_data.data();
+		}
+		auto begin() {
+			return this->m_data.begin();
+		}
+		auto begin() const {
+			return this->m_data.begin();
+		}
+		auto end() {
+			return this->m_data.end();
+		}
+		auto end() const {
+			return this->m_data.end();
+		}
+
+		//mirrors left and right
+		void flip_x() {
+			for (qpl::size y = 0u; y < this->m_height; ++y) {
+				std::reverse(this->m_data.begin() + y * this->m_width, this->m_data.begin() + (y + 1) * this->m_width);
+			}
+		}
+		//mirrors top and bottom
+		void flip_y() {
+			for (qpl::size y = 0u; y < this->m_height / 2; ++y) {
+				std::swap_ranges(this->m_data.begin() + y * this->m_width, this->m_data.begin() + (y + 1) * this->m_width, this->m_data.begin() + (this->m_height - 1 - y) * this->m_width);
+			}
+		}
+		void rotate_180() {
+			std::reverse(this->m_data.begin(), this->m_data.end());
+		}
+		void transpose() {
+			if (this->m_width == this->m_height) {
+				this->transpose_square();
+			}
+			else {
+				std::vector<T> result(this->m_data.size());
+				for (qpl::size ty = 0u; ty < this->m_height; ty += tile_size) {
+					for (qpl::size tx = 0u; tx < this->m_width; tx += tile_size) {
+						auto y_end = qpl::min(ty + tile_size, this->m_height);
+						auto x_end = qpl::min(tx + tile_size, this->m_width);
+						for (qpl::size y = ty; y < y_end; ++y) {
+							for (qpl::size x = tx; x < x_end; ++x) {
+								result[x * this->m_height + y] = std::move(this->m_data[y * this->m_width + x]);
+							}
+						}
+					}
+				}
+				this->m_data = std::move(result);
+				std::swap(this->m_width, this->m_height);
+			}
+		}
+		//clockwise
+		void rotate_right() {
+			this->transpose();
+			this->flip_x();
+		}
+		//counter-clockwise
+		void rotate_left() {
+			this->transpose();
+			this->flip_y();
+		}
+
+	private:
+		void transpose_square() {
+			auto n = this->m_width;
+			auto data = this->m_data.data();
+			for (qpl::size ty = 0u; ty < n; ty += tile_size) {
+				auto y_end = qpl::min(ty + tile_size, n);
+				for (qpl::size y = ty; y < y_end; ++y) {
+					for (qpl::size x = y + 1; x < y_end; ++x) {
+						std::swap(data[y * n + x], data[x * n + y]);
+					}
+				}
+				for (qpl::size tx = ty + tile_size; tx < n; tx += tile_size) {
+					auto x_end = qpl::min(tx + tile_size, n);
+					for (qpl::size y = ty; y < y_end; ++y) {
+						for (qpl::size x = tx; x < x_end; ++x) {
+							std::swap(data[y * n + x], data[x * n + y]);
+						}
+					}
+				}
+			}
+		}
+
+		std::vector<T> m_data;
+		qpl::size m_width = 0u;
+		qpl::size m_height = 0u;
+	};
+
+	template<typename T>
+	void vector_flip_x_axis(qpl::grid<T>& source) {
+		source.flip_x();
+	}
+	template<typename T>
+	void vector_flip_y_axis(qpl::grid<T>& source) {
+		source.flip_y();
+	}
+	template<typename T>
+	void vector_transpose(qpl::grid<T>& source) {
+		source.transpose();
+	}
+	template<typename T>
+	void vector_rotate_right(qpl::grid<T>& source) {
+		source.rotate_right();
+	}
+	template<typename T>
+	void vector_rotate_left(qpl::grid<T>& source) {
+		source.rotate_left();
+	}
+	template<typename T>
+	qpl::grid<T> vector_flip_x_axis_copy(qpl::grid<T> source) {
+		source.flip_x();
+		return source;
+	}
+	template<typename T>
+	qpl::grid<T> vector_flip_y_axis_copy(qpl::grid<T> source) {
+		source.flip_y();
+		return source;
+	}
+	template<typename T>
+	qpl::grid<T> vector_rotate_right_copy(qpl::grid<T> source) {
+		source.rotate_right();
+		return source;
+	}
+	template<typename T>
+	qpl::grid<T> vector_rotate_left_copy(qpl::grid<T> source) {
+		source.rotate_left();
+		return source;
+	}
 }
 
-#endif
\ No newline at end of file
+#endif
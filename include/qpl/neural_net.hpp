@@ -349,7 +349,7 @@ namespace qpl {
 		}
 		template<typename T>
 		T normal_distribution() {
-			return std::sin(2.0 * qpl::pi * qpl::random(std::numeric_limits<double>::epsilon(), 1.0)) * std::sqrt(-2.0 * std::log(qpl::random(std::numeric_limits<double>::epsilon(), 1.0)));
+			return static_cast<T>(qpl::random_normal());
 		}
 		template<typename T>
 		struct synapse {
@@ -430,28 +430,23 @@ namespace qpl {
 				this->accuracy_sum = 0.0;
 				this->generation_ctr = 0u;
 
-
+				std::vector<T> weights;
 				for (qpl::u32 l = 1u; l < this->layers.size(); ++l) {
+					auto deviation = static_cast<T>(std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1)));
+					weights.resize(this->layers[l - 1].neurons.size());
 
 					for (auto& neuron : this->layers[l].neurons) {
 						neuron.gradient = neuron.output = 0.0;
-						neuron.bias = qpl::NN2::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-						neuron.bias *= 0.2;
-
-						//neuron.bias = qpl::random(-1.0, 1.0);
-
-						neuron.synapses.resize(this->layers[l - 1].neurons.size());
+						neuron.bias = static_cast<T>(qpl::random_normal(0.0, deviation * 0.2));
 
+						qpl::fill_random_normal(weights, T{ 0 }, deviation);
+						neuron.synapses.resize(weights.size());
 						for (qpl::u32 s = 0u; s < neuron.synapses.size(); ++s) {
 							neuron.synapses[s].delta_weight = 0.0;
-							//neuron.synapses[s].weight = qpl::random(-1.0, 1.0);
-							neuron.synapses[s].weight = qpl::NN2::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-
+							neuron.synapses[s].weight = weights[s];
 						}
 					}
 				}
-
-
 			}
 
 			void observe_test() const {
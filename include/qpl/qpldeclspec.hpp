@@ -8,5 +8,11 @@
 #define QPLDLL __declspec(dllimport)
 #endif
 
+#ifdef _MSC_VER
+#define QPL_COLD __declspec(noinline)
+#else
+#define QPL_COLD [[gnu::cold, gnu::noinline]]
+#endif
+
 
 #endif
@@ -7,9 +7,12 @@
 #include <qpl/time.hpp>
 #include <qpl/type_traits.hpp>
 #include <array>
+#include <bit>
+#include <cmath>
 #include <iterator>
 #include <type_traits>
 #include <random>
+#include <stdexcept>
 #include <iostream>
 
 namespace qpl {
@@ -231,11 +234,114 @@ namespace qpl {
 	};
 
 	namespace detail {
+		//buffers raw engine output so bulk functions don't call into the engine per element
+		template<qpl::u32 bits>
+		class random_block {
+		public:
+			//capacity limits how many words a refill draws, so short one-off fills don't burn a whole block
+			random_block(qpl::random_engine<bits>& engine, qpl::size capacity = 256u) : m_engine(engine), m_capacity(std::clamp(capacity, qpl::size{ 1 }, qpl::size{ 256 })) {
+
+			}
+			void refill() {
+				//the words are kept at the end of m_data, so m_index == m_data.size() still means empty
+				this->m_index = this->m_data.size() - this->m_capacity;
+				for (qpl::size i = this->m_index; i < this->m_data.size(); ++i) {
+					if constexpr (bits == 32u) {
+						auto high = qpl::u64{ this->m_engine.generate() };
+						this->m_data[i] = (high << 32) | this->m_engine.generate();
+					}
+					else {
+						this->m_data[i] = this->m_engine.generate();
+					}
+				}
+			}
+			qpl::u64 next64() {
+				if (this->m_index == this->m_data.size()) {
+					this->refill();
+				}
+				return this->m_data[this->m_index++];
+			}
+			qpl::u32 next32() {
+				if (this->m_half_used) {
+					this->m_half_used = false;
+					return static_cast<qpl::u32>(this->m_half >> 32);
+				}
+				this->m_half = this->next64();
+				this->m_half_used = true;
+				return static_cast<qpl::u32>(this->m_half);
+			}
+
+			//hands out the remaining buffered words in one go, for loops the compiler can vectorize
+			qpl::span<const qpl::u64> take(qpl::size max_size) {
+				if (this->m_index == this->m_data.size()) {
+					this->refill();
+				}
+				auto size = std::min(max_size, this->m_data.size() - this->m_index);
+				qpl::span<const qpl::u64> result(this->m_data.data() + this->m_index, size);
+				this->m_index += size;
+				return result;
+			}
+			//drops buffered words, e.g. after the engine was reseeded
+			void clear() {
+				this->m_index = this->m_data.size();
+				this->m_half_used = false;
+			}
+		private:
+			qpl::random_engine<bits>& m_engine;
+			std::array<qpl::u64, 256> m_data;
+			qpl::size m_capacity = 256u;
+			qpl::size m_index = 256u;
+			qpl::u64 m_half = 0u;
+			bool m_half_used = false;
+		};
+
+		//Marsaglia & Tsang ziggurat with 128 layers, tables are computed once in random.cpp
+		struct ziggurat_t {
+			ziggurat_t();
+
+			static constexpr qpl::size layers = 128u;
+			static constexpr qpl::f64 r = 3.442619855899;
+			static constexpr qpl::f64 v = 9.91256303526217e-3;
+
+			std::array<qpl::f64, layers + 1> x;
+			std::array<qpl::f64, layers + 1> f;
+		};
+
+		QPLDLL extern const qpl::detail::ziggurat_t ziggurat;
+
+		template<qpl::u32 bits>
+		qpl::f64 ziggurat_normal(qpl::detail::random_block<bits>& block) {
+			const auto& table = qpl::detail::ziggurat;
+			while (true) {
+				auto random = block.next64();
+				auto layer = random & (table.layers - 1);
+				bool negative = (random >> 7) & 0x1u;
+				auto x = static_cast<qpl::f64>(random >> 11) * 0x1p-53 * table.x[layer];
+
+				if (x < table.x[layer + 1]) {
+					return negative ? -x : x;
+				}
+				if (layer == 0u) {
+					qpl::f64 a, b;
+					do {
+						a = -std::log(1.0 - static_cast<qpl::f64>(block.next64() >> 11) * 0x1p-53) / table.r;
+						b = -std::log(1.0 - static_cast<qpl::f64>(block.next64() >> 11) * 0x1p-53);
+					} while (b + b < a * a);
+					return negative ? -(table.r + a) : (table.r + a);
+				}
+				auto u = static_cast<qpl::f64>(block.next64() >> 11) * 0x1p-53;
+				if (table.f[layer + 1] + u * (table.f[layer] - table.f[layer + 1]) < std::exp(-0.5 * x * x)) {
+					return negative ? -x : x;
+				}
+			}
+		}
+
 		struct rng_t {
-			rng_t() {
+			rng_t() : block(this->rng) {
 				this->rng.seed_random();
 			}
 			qpl::random_engine<64> rng;
+			qpl::detail::random_block<64> block;
 			qpl::distribution<qpl::i64> idist;
 			qpl::distribution<qpl::u64> udist;
 			qpl::distribution<qpl::f64> fdist;
@@ -283,6 +389,133 @@ namespace qpl {
 
 	QPLDLL qpl::f64 random_falling(qpl::f64 n);
 
+	namespace detail {
+		template<typename T, qpl::u32 bits>
+		void fill_random(qpl::span<T> data, T min, T max, qpl::detail::random_block<bits>& block) {
+			if constexpr (qpl::is_stl_floating_point<T>()) {
+				qpl::size position = 0u;
+				while (position < data.size()) {
+					auto random = block.take(data.size() - position);
+					auto ptr = data.data() + position;
+					for (qpl::size i = 0u; i < random.size(); ++i) {
+						T u;
+						if constexpr (qpl::is_same<T, qpl::f32>()) {
+							u = static_cast<T>(random[i] >> 40) * 0x1p-24f;
+						}
+						else {
+							u = static_cast<T>(static_cast<qpl::f64>(random[i] >> 11) * 0x1p-53);
+						}
+						ptr[i] = min * (T{ 1 } - u) + max * u;
+						//the interpolation can round up to max, keep the range half open
+						if (ptr[i] >= max && min < max) {
+							ptr[i] = std::nextafter(max, min);
+						}
+					}
+					position += random.size();
+				}
+			}
+			else {
+				auto base = static_cast<qpl::u64>(min);
+				auto range = static_cast<qpl::u64>(max) - base + 1u;
+
+				if (range == 0u) {
+					for (auto& i : data) {
+						i = static_cast<T>(block.next64());
+					}
+				}
+				else if (range <= (qpl::u64{ 1 } << 32)) {
+					auto threshold = static_cast<qpl::u32>((qpl::u64{ 1 } << 32) % range);
+					for (auto& i : data) {
+						auto product = qpl::u64{ block.next32() } * range;
+						while (static_cast<qpl::u32>(product) < threshold) {
+							product = qpl::u64{ block.next32() } * range;
+						}
+						i = static_cast<T>(base + (product >> 32));
+					}
+				}
+				else {
+					auto mask = qpl::u64_max >> std::countl_zero(range - 1);
+					for (auto& i : data) {
+						auto random = block.next64() & mask;
+						while (random >= range) {
+							random = block.next64() & mask;
+						}
+						i = static_cast<T>(base + random);
+					}
+				}
+			}
+		}
+	}
+
+	//fills data with uniform values in [min, max] (integers) or [min, max) (floating points).
+	//engine output is drawn in blocks, integers use lemire's multiply-shift reduction instead of a distribution per element.
+	template<typename T, qpl::u32 bits, QPLCONCEPT((qpl::is_stl_arithmetic<T>() && !qpl::is_same<T, bool>()))>
+	void fill_random(qpl::span<T> data, T min, T max, qpl::random_engine<bits>& engine) {
+		qpl::detail::random_block<bits> block(engine, data.size());
+		qpl::detail::fill_random(data, min, max, block);
+	}
+	template<typename T, QPLCONCEPT((qpl::is_stl_arithmetic<T>() && !qpl::is_same<T, bool>()))>
+	void fill_random(qpl::span<T> data, T min, T max) {
+		qpl::detail::fill_random(data, min, max, qpl::detail::rng.block);
+	}
+	template<typename T, QPLCONCEPT((qpl::is_stl_arithmetic<T>() && !qpl::is_same<T, bool>()))>
+	void fill_random(std::vector<T>& data, T min, T max) {
+		qpl::fill_random(qpl::span<T>(data.data(), data.size()), min, max);
+	}
+
+	//normal distribution via the ziggurat method. keeps a block of engine output between calls,
+	//so single generate() calls are as cheap as the batch fill()
+	template<qpl::u32 bits>
+	class normal_sampler {
+	public:
+		normal_sampler(qpl::random_engine<bits>& engine, qpl::f64 mu = 0.0, qpl::f64 sigma = 1.0) : mu(mu), sigma(sigma), m_block(engine) {
+
+		}
+		qpl::f64 generate() {
+			return qpl::detail::ziggurat_normal(this->m_block) * this->sigma + this->mu;
+		}
+		qpl::f64 operator()() {
+			return this->generate();
+		}
+		template<typename T, QPLCONCEPT(qpl::is_stl_floating_point<T>())>
+		void fill(qpl::span<T> data) {
+			for (auto& i : data) {
+				i = static_cast<T>(qpl::detail::ziggurat_normal(this->m_block) * this->sigma + this->mu);
+			}
+		}
+		template<typename T, QPLCONCEPT(qpl::is_stl_floating_point<T>())>
+		void fill(std::vector<T>& data) {
+			this->fill(qpl::span<T>(data.data(), data.size()));
+		}
+		//call after reseeding the engine
+		void clear() {
+			this->m_block.clear();
+		}
+
+		qpl::f64 mu = 0.0;
+		qpl::f64 sigma = 1.0;
+	private:
+		qpl::detail::random_block<bits> m_block;
+	};
+
+	//fills data with normally distributed values (ziggurat method)
+	template<typename T, qpl::u32 bits, QPLCONCEPT(qpl::is_stl_floating_point<T>())>
+	void fill_random_normal(qpl::span<T> data, T mu, T sigma, qpl::random_engine<bits>& engine) {
+		qpl::normal_sampler<bits> sampler(engine, mu, sigma);
+		sampler.fill(data);
+	}
+	template<typename T, QPLCONCEPT(qpl::is_stl_floating_point<T>())>
+	void fill_random_normal(qpl::span<T> data, T mu = T{ 0 }, T sigma = T{ 1 }) {
+		for (auto& i : data) {
+			i = static_cast<T>(qpl::detail::ziggurat_normal(qpl::detail::rng.block) * sigma + mu);
+		}
+	}
+	template<typename T, QPLCONCEPT(qpl::is_stl_floating_point<T>())>
+	void fill_random_normal(std::vector<T>& data, T mu = T{ 0 }, T sigma = T{ 1 }) {
+		qpl::fill_random_normal(qpl::span<T>(data.data(), data.size()), mu, sigma);
+	}
+	QPLDLL qpl::f64 random_normal(qpl::f64 mu = 0.0, qpl::f64 sigma = 1.0);
+
 	template<typename C>
 	void shuffle(C& data) {
 		
@@ -301,7 +534,7 @@ namespace qpl {
 	
 
 	template<typename T>
-	qpl::u32 random_weighted_index(std::vector<T> weights) {
+	qpl::u32 random_weighted_index(const std::vector<T>& weights) {
 		std::decay_t<T> sum = 0;
 		for (auto& i : weights) {
 			sum += i;
@@ -338,6 +571,257 @@ namespace qpl {
 		return weights.size();
 	}
 
+	//Vose alias method: O(n) build, O(1) generate.
+	//set_weight updates a fenwick tree in O(log n) - generate falls back to an O(log n) search
+	//until the alias table is rebuilt, which happens automatically after size() generates without an update.
+	template<typename T>
+	class weighted_sampler {
+	public:
+		//wide enough that sums of narrow integer weights don't overflow
+		using sum_type = std::conditional_t<qpl::is_floating_point<T>(), qpl::f64, std::conditional_t<std::is_signed_v<T>, qpl::i64, qpl::u64>>;
+
+		weighted_sampler() {
+
+		}
+		weighted_sampler(const std::vector<T>& weights) {
+			this->set_weights(weights);
+		}
+		weighted_sampler(qpl::span<const T> weights) {
+			this->set_weights(weights);
+		}
+
+		void set_weights(const std::vector<T>& weights) {
+			this->set_weights(qpl::span<const T>(weights.data(), weights.size()));
+		}
+		//throws std::invalid_argument for negative weights
+		void set_weights(qpl::span<const T> weights) {
+			for (auto& weight : weights) {
+				this->check_weight(weight);
+			}
+			this->m_weights.assign(weights.begin(), weights.end());
+			this->build_tree();
+			this->build_table();
+		}
+		void set_weight(qpl::size index, T weight) {
+			this->check_weight(weight);
+			sum_type delta = static_cast<sum_type>(weight) - static_cast<sum_type>(this->m_weights[index]);
+			this->m_weights[index] = weight;
+			for (qpl::size i = index + 1; i <= this->m_tree.size(); i += (i & (~i + 1))) {
+				this->m_tree[i - 1] += delta;
+			}
+			this->m_sum += delta;
+			this->m_table_valid = false;
+			this->m_generates_since_update = 0u;
+		}
+		void add_weight(qpl::size index, T delta) {
+			this->set_weight(index, this->m_weights[index] + delta);
+		}
+		T get_weight(qpl::size index) const {
+			return this->m_weights[index];
+		}
+		const std::vector<T>& get_weights() const {
+			return this->m_weights;
+		}
+		sum_type get_sum() const {
+			return this->m_sum;
+		}
+		qpl::f64 get_probability(qpl::size index) const {
+			if (this->m_sum == sum_type{}) {
+				return 0.0;
+			}
+			return static_cast<qpl::f64>(this->m_weights[index]) / static_cast<qpl::f64>(this->m_sum);
+		}
+		qpl::size size() const {
+			return this->m_weights.size();
+		}
+		bool empty() const {
+			return this->m_weights.empty();
+		}
+		bool table_valid() const {
+			return this->m_table_valid;
+		}
+		void clear() {
+			this->m_weights.clear();
+			this->m_tree.clear();
+			this->m_table.clear();
+			this->m_sum = sum_type{};
+			this->m_table_valid = false;
+			this->m_generates_since_update = 0u;
+		}
+
+		//rebuilds the alias table from the current weights (and resynchronizes the fenwick tree)
+		void rebuild() {
+			this->build_tree();
+			this->build_table();
+		}
+
+		template<qpl::u32 bits>
+		qpl::u32 generate(qpl::random_engine<bits>& engine) {
+			if (this->m_weights.empty()) {
+				return 0u;
+			}
+			if (!this->m_table_valid) {
+				++this->m_generates_since_update;
+				if (this->m_generates_since_update >= this->m_weights.size()) {
+					this->rebuild();
+				}
+				else {
+					return this->generate_tree(engine);
+				}
+			}
+			if constexpr (bits == 32u) {
+				auto high = qpl::u64{ engine.generate() };
+				return this->generate_table((high << 32) | engine.generate());
+			}
+			else {
+				return this->generate_table(engine.generate());
+			}
+		}
+		qpl::u32 generate() {
+			return this->generate(qpl::detail::rng.rng);
+		}
+		qpl::u32 operator()() {
+			return this->generate();
+		}
+
+		//O(log n), independent of the alias table
+		template<qpl::u32 bits>
+		qpl::u32 generate_tree(qpl::random_engine<bits>& engine) const {
+			if (this->m_weights.empty()) {
+				return 0u;
+			}
+			//all weights zero: uniform, same as the alias table
+			if (this->m_sum <= sum_type{}) {
+				return static_cast<qpl::u32>(engine.generate(qpl::size{ 0 }, this->m_weights.size() - 1));
+			}
+			sum_type target;
+			if constexpr (qpl::is_floating_point<T>()) {
+				target = engine.generate(0.0, this->m_sum);
+			}
+			else {
+				target = engine.generate(sum_type{}, static_cast<sum_type>(this->m_sum - 1));
+			}
+
+			qpl::size position = 0u;
+			qpl::size step = 1u;
+			while (step * 2 <= this->m_tree.size()) {
+				step *= 2;
+			}
+			for (; step; step /= 2) {
+				auto next = position + step;
+				if (next <= this->m_tree.size() && this->m_tree[next - 1] <= target) {
+					target -= this->m_tree[next - 1];
+					position = next;
+				}
+			}
+
+			//floating point rounding can push the target past the last non-zero weight
+			while (position >= this->m_weights.size() || (this->m_weights[position] <= T{} && position)) {
+				--position;
+			}
+			return static_cast<qpl::u32>(position);
+		}
+
+	private:
+		struct alias_entry {
+			qpl::u64 threshold;
+			qpl::u32 alias;
+		};
+
+		static void check_weight(T weight) {
+			if constexpr (std::is_signed_v<T> || qpl::is_floating_point<T>()) {
+				if (weight < T{}) {
+					throw std::invalid_argument("qpl::weighted_sampler: weights can't be negative");
+				}
+			}
+		}
+
+		qpl::u32 generate_table(qpl::u64 random) const {
+			auto index = static_cast<qpl::u32>(((random >> 32) * this->m_table.size()) >> 32);
+			const auto& entry = this->m_table[index];
+			if ((random & qpl::u32_max) < entry.threshold) {
+				return index;
+			}
+			return entry.alias;
+		}
+
+		void build_tree() {
+			this->m_tree.resize(this->m_weights.size());
+			this->m_sum = sum_type{};
+			for (qpl::size i = 0u; i < this->m_weights.size(); ++i) {
+				this->m_tree[i] = static_cast<sum_type>(this->m_weights[i]);
+				this->m_sum += this->m_tree[i];
+			}
+			for (qpl::size i = 1u; i <= this->m_tree.size(); ++i) {
+				auto parent = i + (i & (~i + 1));
+				if (parent <= this->m_tree.size()) {
+					this->m_tree[parent - 1] += this->m_tree[i - 1];
+				}
+			}
+		}
+		void build_table() {
+			auto n = this->m_weights.size();
+			this->m_table.resize(n);
+			this->m_table_valid = true;
+			this->m_generates_since_update = 0u;
+			if (!n) {
+				return;
+			}
+
+			constexpr qpl::f64 one = static_cast<qpl::f64>(qpl::u64{ 1 } << 32);
+			if (this->m_sum <= sum_type{}) {
+				for (qpl::size i = 0u; i < n; ++i) {
+					this->m_table[i] = alias_entry{ qpl::u64{ 1 } << 32, static_cast<qpl::u32>(i) };
+				}
+				return;
+			}
+
+			std::vector<qpl::f64> scaled(n);
+			std::vector<qpl::u32> small;
+			std::vector<qpl::u32> large;
+			small.reserve(n);
+			large.reserve(n);
+
+			auto factor = static_cast<qpl::f64>(n) / static_cast<qpl::f64>(this->m_sum);
+			for (qpl::size i = 0u; i < n; ++i) {
+				scaled[i] = static_cast<qpl::f64>(this->m_weights[i]) * factor;
+				if (scaled[i] < 1.0) {
+					small.push_back(static_cast<qpl::u32>(i));
+				}
+				else {
+					large.push_back(static_cast<qpl::u32>(i));
+				}
+			}
+			while (!small.empty() && !large.empty()) {
+				auto s = small.back();
+				small.pop_back();
+				auto l = large.back();
+
+				this->m_table[s] = alias_entry{ static_cast<qpl::u64>(scaled[s] * one), l };
+				scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+				if (scaled[l] < 1.0) {
+					large.pop_back();
+					small.push_back(l);
+				}
+			}
+
+			//leftovers only differ from 1.0 by rounding errors
+			for (auto& i : large) {
+				this->m_table[i] = alias_entry{ qpl::u64{ 1 } << 32, i };
+			}
+			for (auto& i : small) {
+				this->m_table[i] = alias_entry{ qpl::u64{ 1 } << 32, i };
+			}
+		}
+
+		std::vector<T> m_weights;
+		std::vector<sum_type> m_tree;
+		std::vector<alias_entry> m_table;
+		sum_type m_sum = sum_type{};
+		qpl::size m_generates_since_update = 0u;
+		bool m_table_valid = false;
+	};
+
 	template<typename T, typename U, typename ...Args>
 	T random_element(T&& first, U&& second, Args&&... n) {
 		return qpl::random_element(std::vector<T>{ first, second, n... });
@@ -363,8 +847,13 @@ namespace qpl {
 	template<typename T>
 	std::vector<T> random_vector(qpl::size size, T min = qpl::type_min<T>(), T max = qpl::type_max<T>()) {
 		std::vector<T> result(size);
-		for (qpl::u32 i = 0u; i < size; ++i) {
-			result[i] = qpl::random(min, max);
+		if constexpr (qpl::is_stl_arithmetic<T>() && !qpl::is_same<T, bool>()) {
+			qpl::fill_random(result, min, max);
+		}
+		else {
+			for (qpl::u32 i = 0u; i < size; ++i) {
+				result[i] = qpl::random(min, max);
+			}
 		}
 		return result;
 	}
@@ -6,6 +6,7 @@
 #include <qpl/qpldeclspec.hpp>
 #include <qpl/algorithm.hpp>
 #include <qpl/string.hpp>
+#include <iterator>
 #include <vector>
 
 namespace qpl {
@@ -48,41 +49,273 @@ namespace qpl {
 		U c = U{ 1 };
 	};
 
-	template<typename T>
-	std::vector<std::vector<T>> list_all_permutations(const std::vector<std::vector<T>>& ranges) {
-		std::vector<std::vector<T>> result;
-
-		std::vector<qpl::u32> indices(ranges.size());
+	namespace detail {
+		struct accept_all {
+			template<typename T>
+			constexpr bool operator()(qpl::span<const T>) const {
+				return true;
+			}
+		};
 
-		qpl::size sum = 1u;
-		for (qpl::u32 i = 0u; i < ranges.size(); ++i) {
-			auto possibilities = ranges[i];
-			sum *= possibilities.size();
+		constexpr qpl::u64 binomial(qpl::u64 n, qpl::u64 k) {
+			if (k > n) {
+				return 0u;
+			}
+			k = qpl::min(k, n - k);
+			qpl::u64 result = 1u;
+			for (qpl::u64 i = 1u; i <= k; ++i) {
+				result = result * (n - k + i) / i;
+			}
+			return result;
 		}
 
-		result.resize(sum);
-		for (qpl::u32 i = 0u; i < sum; ++i) {
-			result[i].resize(indices.size());
-			for (qpl::u32 j = 0u; j < indices.size(); ++j) {
-				auto index = indices.size() - 1 - j;
-				if (i) {
-					++indices[index];
+		//enumerates tuples of indices one at a time into a reused buffer. either the cartesian product of ranges
+		//(last position changes fastest) or the combinations of size elements of array in lexicographic order.
+		//accept(prefix) is asked whenever position d changes, returning false skips everything starting with that prefix.
+		//elements are numbered 0 .. size() - 1 as if nothing was pruned, slice(first, last) enumerates only that part
+		template<typename T, typename F, bool combination>
+		class prefix_range {
+		public:
+			class iterator {
+			public:
+				using value_type = std::vector<T>;
+				using difference_type = std::ptrdiff_t;
+
+				iterator(prefix_range* range = nullptr) : m_range(range) {
+
+				}
+				const std::vector<T>& operator*() const {
+					return this->m_range->m_current;
+				}
+				const std::vector<T>* operator->() const {
+					return &this->m_range->m_current;
+				}
+				iterator& operator++() {
+					this->m_range->advance();
+					return *this;
+				}
+				void operator++(int) {
+					this->m_range->advance();
+				}
+				bool operator==(std::default_sentinel_t) const {
+					return this->m_range->m_done;
+				}
+				bool operator!=(std::default_sentinel_t) const {
+					return !this->m_range->m_done;
+				}
+			private:
+				prefix_range* m_range;
+			};
+
+			//product of ranges
+			prefix_range(const std::vector<std::vector<T>>& ranges, F accept) requires (!combination) : m_ranges(&ranges), m_accept(std::move(accept)) {
+				this->m_positions = ranges.size();
+				this->m_weights.resize(this->m_positions);
+				qpl::u64 weight = 1u;
+				for (qpl::size d = this->m_positions; d-- > 0u;) {
+					this->m_weights[d] = weight;
+					weight *= ranges[d].size();
+				}
+				this->m_size = weight;
+				this->m_last = this->m_size;
+			}
+			//combinations of size elements of array
+			prefix_range(const std::vector<T>& array, qpl::size size, F accept) requires (combination) : m_array(&array), m_accept(std::move(accept)) {
+				this->m_positions = size;
+				this->m_size = qpl::detail::binomial(array.size(), size);
+				this->m_last = this->m_size;
+			}
+
+			qpl::u64 size() const {
+				return this->m_size;
+			}
+			//number of the element the iterator is on
+			qpl::u64 index() const {
+				return this->m_base.empty() ? this->m_first : this->m_base.back();
+			}
+			prefix_range slice(qpl::u64 first, qpl::u64 last) const {
+				auto result = *this;
+				result.m_first = qpl::min(first, this->m_size);
+				result.m_last = qpl::min(last, this->m_size);
+				return result;
+			}
+			//splits [0, size()) into parts slices of about the same size, e.g. one per thread
+			std::vector<prefix_range> partition(qpl::size parts) const {
+				parts = qpl::max(parts, qpl::size{ 1u });
+				std::vector<prefix_range> result;
+				result.reserve(parts);
+				auto count = this->m_last - this->m_first;
+				for (qpl::size i = 0u; i < parts; ++i) {
+					result.push_back(this->slice(this->m_first + count * i / parts, this->m_first + count * (i + 1) / parts));
+				}
+				return result;
+			}
+
+			iterator begin() {
+				this->restart();
+				return iterator(this);
+			}
+			std::default_sentinel_t end() {
+				return {};
+			}
+
+			std::vector<std::vector<T>> to_vector() {
+				std::vector<std::vector<T>> result;
+				if (this->m_last - this->m_first == this->m_size) {
+					result.reserve(this->m_size);
+				}
+				for (auto& i : *this) {
+					result.push_back(i);
+				}
+				return result;
+			}
+
+		private:
+			qpl::size index_begin(qpl::size d) const {
+				if constexpr (combination) {
+					return d ? this->m_indices[d - 1] + 1 : 0u;
+				}
+				else {
+					return 0u;
+				}
+			}
+			qpl::size index_end(qpl::size d) const {
+				if constexpr (combination) {
+					return this->m_array->size() - (this->m_positions - 1 - d);
+				}
+				else {
+					return (*this->m_ranges)[d].size();
+				}
+			}
+			//amount of elements that start with the prefix up to position d
+			qpl::u64 subtree_size(qpl::size d) const {
+				if constexpr (combination) {
+					return qpl::detail::binomial(this->m_array->size() - 1 - this->m_indices[d], this->m_positions - 1 - d);
+				}
+				else {
+					return this->m_weights[d];
 				}
-				if (indices[index] >= ranges[index].size()) {
-					indices[index] = 0u;
+			}
+			const T& value(qpl::size d) const {
+				if constexpr (combination) {
+					return (*this->m_array)[this->m_indices[d]];
 				}
 				else {
-					break;
+					return (*this->m_ranges)[d][this->m_indices[d]];
 				}
 			}
+			qpl::u64 base(qpl::size d) const {
+				return d ? this->m_base[d - 1] : this->m_first_base;
+			}
 
-			for (qpl::u32 j = 0u; j < indices.size(); ++j) {
-				result[i][j] = ranges[j][indices[j]];
+			void restart() {
+				this->m_done = this->m_first >= this->m_last;
+				this->m_indices.resize(this->m_positions);
+				this->m_base.resize(this->m_positions);
+				this->m_current.resize(this->m_positions);
+				this->m_first_base = 0u;
+				if (this->m_done) {
+					return;
+				}
+
+				//unrank m_first
+				auto rank = this->m_first;
+				for (qpl::size d = 0u; d < this->m_positions; ++d) {
+					this->m_indices[d] = this->index_begin(d);
+					this->m_base[d] = this->base(d);
+					while (this->subtree_size(d) <= rank) {
+						rank -= this->subtree_size(d);
+						this->m_base[d] += this->subtree_size(d);
+						++this->m_indices[d];
+					}
+				}
+				if (!this->m_positions) {
+					this->m_first_base = this->m_first;
+				}
+				this->seek(0u);
+			}
+			//positions from depth on were changed. fills the buffer and skips rejected prefixes
+			void seek(qpl::size depth) {
+				while (!this->m_done) {
+					if (this->index() >= this->m_last) {
+						this->m_done = true;
+						return;
+					}
+					bool accepted = true;
+					for (qpl::size d = depth; d < this->m_positions; ++d) {
+						this->m_current[d] = this->value(d);
+						if constexpr (!std::is_same_v<F, qpl::detail::accept_all>) {
+							if (!this->m_accept(qpl::span<const T>(this->m_current.data(), d + 1))) {
+								depth = this->step(d);
+								accepted = false;
+								break;
+							}
+						}
+					}
+					if (accepted) {
+						return;
+					}
+				}
+			}
+			//moves past every element that starts with the prefix up to position depth, returns the first changed position
+			qpl::size step(qpl::size depth) {
+				for (qpl::size d = depth + 1; d-- > 0u;) {
+					this->m_base[d] += this->subtree_size(d);
+					++this->m_indices[d];
+					if (this->m_indices[d] < this->index_end(d)) {
+						for (qpl::size e = d + 1; e < this->m_positions; ++e) {
+							this->m_indices[e] = this->index_begin(e);
+							this->m_base[e] = this->m_base[e - 1];
+						}
+						return d;
+					}
+				}
+				this->m_done = true;
+				return 0u;
+			}
+			void advance() {
+				if (!this->m_positions) {
+					this->m_done = true;
+					return;
+				}
+				this->seek(this->step(this->m_positions - 1));
 			}
-			//qpl::println_container(result[i]);
-		}
 
-		return result;
+			const std::vector<std::vector<T>>* m_ranges = nullptr;
+			const std::vector<T>* m_array = nullptr;
+			F m_accept;
+			qpl::size m_positions = 0u;
+			std::vector<qpl::u64> m_weights;
+			std::vector<qpl::size> m_indices;
+			std::vector<qpl::u64> m_base;
+			std::vector<T> m_current;
+			qpl::u64 m_size = 0u;
+			qpl::u64 m_first = 0u;
+			qpl::u64 m_last = 0u;
+			qpl::u64 m_first_base = 0u;
+			bool m_done = true;
+		};
+	}
+
+	//lazy version of list_all_permutations(ranges). ranges has to outlive the returned range
+	template<typename T, typename F = qpl::detail::accept_all>
+	auto permutations_range(const std::vector<std::vector<T>>& ranges, F accept = {}) {
+		return qpl::detail::prefix_range<T, F, false>(ranges, std::move(accept));
+	}
+	//lazy version of list_all_arrangements(array, size). array has to outlive the returned range
+	template<typename T, typename F = qpl::detail::accept_all>
+	auto arrangements_range(const std::vector<T>& array, qpl::size size, F accept = {}) {
+		return qpl::detail::prefix_range<T, F, true>(array, size, std::move(accept));
+	}
+
+	template<typename T, typename F = qpl::detail::accept_all>
+	auto permutations_range(std::vector<std::vector<T>>&& ranges, F accept = {}) = delete;
+	template<typename T, typename F = qpl::detail::accept_all>
+	auto arrangements_range(std::vector<T>&& array, qpl::size size, F accept = {}) = delete;
+
+	template<typename T>
+	std::vector<std::vector<T>> list_all_permutations(const std::vector<std::vector<T>>& ranges) {
+		return qpl::permutations_range(ranges).to_vector();
 	}
 
 
@@ -110,36 +343,7 @@ namespace qpl {
 
 	template<typename T>
 	std::vector<std::vector<T>> list_all_arrangements(const std::vector<T>& array, qpl::size size) {
-		std::vector<qpl::u32> indices = qpl::vector_0_to_n<qpl::u32>(size);
-
-		std::vector<std::vector<T>> result;
-		while (true) {
-			result.push_back({});
-			result.back().resize(size);
-			for (qpl::u32 i = 0u; i < size; ++i) {
-				result.back()[i] = array[indices[i]];
-			}
-
-			qpl::i32 index = size - 1;
-
-			qpl::u32 max = array.size() - 1;
-			while (indices[index] >= max) {
-				if (index < 1) {
-					return result;
-				}
-
-				--max;
-				--index;
-			}
-
-			++indices[index];
-			for (qpl::u32 j = index; j < size; ++j) {
-				if (j < size - 1) {
-					indices[j + 1] = indices[j] + 1;
-				}
-			}
-		}
-		return result;
+		return qpl::arrangements_range(array, size).to_vector();
 	}
 }
 
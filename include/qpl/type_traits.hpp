@@ -3,6 +3,7 @@
 #pragma once
 
 #include <type_traits>
+#include <functional>
 #include <limits>
 #include <tuple>
 #include <string>
@@ -584,6 +585,26 @@ namespace qpl {
 	constexpr bool has_size() {
 		return has_size_t<T>::value;
 	}
+
+	template<typename T, typename = void>
+	struct is_hashable_t : std::false_type {};
+	template<typename T>
+	struct is_hashable_t<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_hashable() {
+		return is_hashable_t<T>::value;
+	}
+
+	template<typename T, typename = void>
+	struct is_less_comparable_t : std::false_type {};
+	template<typename T>
+	struct is_less_comparable_t<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_less_comparable() {
+		return is_less_comparable_t<T>::value;
+	}
 #else
 	template<typename T>
 	concept is_container_c = requires(T a, const T b) {
@@ -618,6 +639,24 @@ namespace qpl {
 	constexpr bool has_size() {
 		return has_size_c<T>;
 	}
+
+	template<typename T>
+	concept is_hashable_c = requires(const T x) {
+		std::hash<T>{}(x);
+	};
+	template<typename T>
+	constexpr bool is_hashable() {
+		return is_hashable_c<T>;
+	}
+
+	template<typename T>
+	concept is_less_comparable_c = requires(const T a, const T b) {
+		a < b;
+	};
+	template<typename T>
+	constexpr bool is_less_comparable() {
+		return is_less_comparable_c<T>;
+	}
 #endif
 
 
@@ -3448,9 +3448,9 @@ namespace qsf {
 			else {
 				auto span = this->get_info_graph_span(g.first);
 
-				auto result = qpl::min_max_vector(span, this->index_skip_size);
+				auto result = qpl::min_max_reduce(span, this->index_skip_size, &qsf::vgraph::data_point_info::data);
 
-				std::tie(min, max) = std::make_pair(result.first.data, result.second.data);
+				std::tie(min, max) = std::make_pair(result.min, result.max);
 			}
 
 
@@ -3481,9 +3481,9 @@ namespace qsf {
 			else {
 				auto span = this->get_standard_graph_span(g.first);
 
-				auto result = qpl::min_max_vector(span, this->index_skip_size);
+				auto result = qpl::min_max_reduce(span, this->index_skip_size, &qsf::vgraph::data_point::data);
 
-				std::tie(min, max) = std::make_pair(result.first.data, result.second.data);
+				std::tie(min, max) = std::make_pair(result.min, result.max);
 			}
 
 
@@ -3515,9 +3515,9 @@ namespace qsf {
 			else {
 				auto span = this->get_simple_graph_span(g.first);
 
-				auto result = qpl::min_max_vector(span, this->index_skip_size);
+				auto result = qpl::min_max_reduce(span, this->index_skip_size, &qsf::vgraph::data_point_simple::data);
 
-				std::tie(min, max) = std::make_pair(result.first.data, result.second.data);
+				std::tie(min, max) = std::make_pair(result.min, result.max);
 
 			}
 
@@ -99,7 +99,10 @@ namespace qpl {
 		this->cipher();
 		return this->get_message();
 	}
-	std::vector<qpl::u8> qpl::AES::encrypted(const qpl::u8* message, qpl::size size, const std::string& key) {
+	qpl::size qpl::AES::encrypted_size(qpl::size size) {
+		return ((size + 15u) / 16u) * 16u;
+	}
+	void qpl::AES::encrypt_blocks(const qpl::u8* message, qpl::size size, const std::string& key, qpl::u8* destination) {
 		this->set_key(key);
 		this->expand_key();
 
@@ -107,9 +110,6 @@ namespace qpl {
 		qpl::u8 input_block[16];
 		bool first_block = true;
 
-		std::vector<qpl::u8> result;
-		result.reserve((((size ? size - 1 : 0) / 16) + 1) * 16);
-
 		qpl::size length = size;
 		for (qpl::size i = 0u; i < length / 16u; ++i) {
 			if (first_block) {
@@ -125,74 +125,36 @@ namespace qpl {
 			}
 			this->set_state(input_block);
 			this->cipher();
-			for (int i = 0; i < 16; ++i) {
-				result.push_back(this->m_state[i]);
-			}
-			std::memcpy(last_block, this->m_state, 16);
+			std::memcpy(destination + i * 16u, this->m_state, 16u);
+			std::memcpy(last_block, this->m_state, 16u);
 		}
-		if (size % 16) {
+		if (size % 16u) {
 			if (first_block) {
 				for (int c = 0; c < 16; ++c) {
-					if (c >= size % 16) {
+					if (c >= size % 16u) {
 						input_block[c] = qpl::u8{};
 					}
 					else {
-						input_block[c] = message[(size / 16) * 16 + c];
+						input_block[c] = message[(size / 16u) * 16u + c];
 					}
 				}
 			}
 			else {
 				for (int c = 0; c < 16; ++c) {
-					if (c >= size % 16) {
+					if (c >= size % 16u) {
 						input_block[c] = last_block[c] ^ qpl::u8{};
 					}
 					else {
-						input_block[c] = last_block[c] ^ message[(size / 16) * 16 + c];
+						input_block[c] = last_block[c] ^ message[(size / 16u) * 16u + c];
 					}
 				}
 			}
 			this->set_state(input_block);
 			this->cipher();
-			for (int i = 0; i < 16; ++i) {
-				result.push_back(this->m_state[i]);
-			}
+			std::memcpy(destination + (size / 16u) * 16u, this->m_state, 16u);
 		}
-
-		return result;
-	}
-	std::string qpl::AES::encrypted(const std::string& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length(), key);
-		return std::string(std::move(reinterpret_cast<const char*>(s.data())), s.size());
-	}
-	std::wstring qpl::AES::encrypted(const std::wstring& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length() * (sizeof(wchar_t) / sizeof(char)), key);
-		return std::wstring(std::move(reinterpret_cast<const wchar_t*>(s.data())), s.size() / (sizeof(wchar_t) / sizeof(char)));
-	}
-	std::string qpl::AES::encrypted(const std::vector<char>& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.data()), message.size(), key);
-		return std::string(std::move(reinterpret_cast<const char*>(s.data())), s.size());
-	}
-	std::wstring qpl::AES::encrypted(const std::vector<wchar_t>& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.data()), message.size() * (sizeof(wchar_t) / sizeof(char)), key);
-		return std::wstring(std::move(reinterpret_cast<const wchar_t*>(s.data())), s.size() / (sizeof(wchar_t) / sizeof(char)));
-	}
-	void qpl::AES::encrypt(std::string& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length(), key);
-		qpl::container_memory_to_string(s, message);
 	}
-	void qpl::AES::encrypt(std::wstring& message, const std::string& key) {
-		auto s = qpl::AES::encrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length()* (sizeof(wchar_t) / sizeof(char)), key);
-		qpl::container_memory_to_wstring(s, message);
-	}
-
-	std::string qpl::AES::decrypted(const qpl::u8 message[16], const std::string& key) {
-		this->set_state(message);
-		this->set_key(key);
-		this->expand_key();
-		this->decipher();
-		return this->get_message();
-	}
-	std::vector<qpl::u8> qpl::AES::decrypted(const qpl::u8* message, qpl::size size, const std::string& key, bool remove_null_terminations) {
+	qpl::size qpl::AES::decrypt_blocks(const qpl::u8* message, qpl::size size, const std::string& key, qpl::u8* destination, bool remove_null_terminations) {
 		this->set_key(key);
 		this->expand_key();
 
@@ -201,10 +163,6 @@ namespace qpl {
 		qpl::u8 output_block[16];
 		bool first_block = true;
 
-		std::vector<qpl::u8> result;
-		//result.reserve((((size ? size - 1 : 0) / 16) + 1) * 16);
-		result.reserve(size);
-
 		qpl::size length = size;
 		for (qpl::size i = 0; i < length / 16u; ++i) {
 			for (int c = 0; c < 16; ++c) {
@@ -223,21 +181,19 @@ namespace qpl {
 					output_block[c] = last_block[c] ^ this->m_state[c];
 				}
 			}
-			for (int i = 0; i < 16; ++i) {
-				result.push_back(output_block[i]);
-			}
+			std::memcpy(destination + i * 16u, output_block, 16u);
 			std::memcpy(last_block, input_block, 16u);
 		}
 		if (size % 16u) {
 			for (qpl::size c = 0; c < 16u; ++c) {
-				input_block[c] = c >= size ? 0 : message[(size / 16u) * 16u + c];
+				input_block[c] = c >= size % 16u ? 0 : message[(size / 16u) * 16u + c];
 			}
 
 			this->set_state(input_block);
 			this->decipher();
 			if (first_block) {
 				for (int c = 0; c < 16; ++c) {
-					if (c >= size) {
+					if (c >= size % 16u) {
 						output_block[c] = qpl::u8{};
 					}
 					else {
@@ -247,7 +203,7 @@ namespace qpl {
 			}
 			else {
 				for (int c = 0; c < 16; ++c) {
-					if (c >= size) {
+					if (c >= size % 16u) {
 						output_block[c] = last_block[c] ^ qpl::u8{};
 					}
 					else {
@@ -255,42 +211,105 @@ namespace qpl {
 					}
 				}
 			}
-			for (int i = 0; i < 16; ++i) {
-				result.push_back(output_block[i]);
-			}
+			std::memcpy(destination + (size / 16u) * 16u, output_block, 16u);
 		}
-		if (remove_null_terminations) {
-			auto last = result.size() - 1;
-			while (last && result[last] == qpl::u8{}) { --last; }
-			result.resize(last + 1);
+		auto result_size = qpl::AES::encrypted_size(size);
+		if (remove_null_terminations && result_size) {
+			auto last = result_size - 1;
+			while (last && destination[last] == qpl::u8{}) { --last; }
+			result_size = last + 1;
 		}
+		return result_size;
+	}
+
+	std::vector<qpl::u8> qpl::AES::encrypted(const qpl::u8* message, qpl::size size, const std::string& key) {
+		std::vector<qpl::u8> result(qpl::AES::encrypted_size(size));
+		this->encrypt_blocks(message, size, key, result.data());
+		return result;
+	}
+	std::string qpl::AES::encrypted(const std::string& message, const std::string& key) {
+		std::string result;
+		result.resize(qpl::AES::encrypted_size(message.length()));
+		this->encrypt_blocks(qpl::as_bytes(message), key, result);
+		return result;
+	}
+	std::wstring qpl::AES::encrypted(const std::wstring& message, const std::string& key) {
+		std::wstring result;
+		result.resize(qpl::AES::encrypted_size(message.length() * sizeof(wchar_t)) / sizeof(wchar_t));
+		this->encrypt_blocks(qpl::as_bytes(message), key, result);
+		return result;
+	}
+	std::string qpl::AES::encrypted(const std::vector<char>& message, const std::string& key) {
+		std::string result;
+		result.resize(qpl::AES::encrypted_size(message.size()));
+		this->encrypt_blocks(qpl::as_bytes(message), key, result);
+		return result;
+	}
+	std::wstring qpl::AES::encrypted(const std::vector<wchar_t>& message, const std::string& key) {
+		std::wstring result;
+		result.resize(qpl::AES::encrypted_size(message.size() * sizeof(wchar_t)) / sizeof(wchar_t));
+		this->encrypt_blocks(qpl::as_bytes(message), key, result);
+		return result;
+	}
+	void qpl::AES::encrypt(std::string& message, const std::string& key) {
+		//in place: block i is read before it is overwritten
+		auto size = message.length();
+		message.resize(qpl::AES::encrypted_size(size));
+		this->encrypt_blocks(qpl::as_bytes(message).first(size), key, message);
+	}
+	void qpl::AES::encrypt(std::wstring& message, const std::string& key) {
+		auto size = message.length() * sizeof(wchar_t);
+		message.resize(qpl::AES::encrypted_size(size) / sizeof(wchar_t));
+		this->encrypt_blocks(qpl::as_bytes(message).first(size), key, message);
+	}
+
+	std::string qpl::AES::decrypted(const qpl::u8 message[16], const std::string& key) {
+		this->set_state(message);
+		this->set_key(key);
+		this->expand_key();
+		this->decipher();
+		return this->get_message();
+	}
+	std::vector<qpl::u8> qpl::AES::decrypted(const qpl::u8* message, qpl::size size, const std::string& key, bool remove_null_terminations) {
+		std::vector<qpl::u8> result(qpl::AES::encrypted_size(size));
+		result.resize(this->decrypt_blocks(message, size, key, result.data(), remove_null_terminations));
 		return result;
 	}
 	
 	std::string qpl::AES::decrypted(const std::string& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length(), key, remove_null_terminations);
-		return std::string(std::move(reinterpret_cast<const char*>(s.data())), s.size());
+		std::string result;
+		result.resize(qpl::AES::encrypted_size(message.length()));
+		result.resize(this->decrypt_blocks(qpl::as_bytes(message), key, result, remove_null_terminations));
+		return result;
 	}
 	std::wstring qpl::AES::decrypted(const std::wstring& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.length() * (sizeof(wchar_t) / sizeof(char)), key, remove_null_terminations);
-		return std::wstring(std::move(reinterpret_cast<const wchar_t*>(s.data())), s.size() / (sizeof(wchar_t) / sizeof(char)));
+		std::wstring result;
+		result.resize(qpl::AES::encrypted_size(message.length() * sizeof(wchar_t)) / sizeof(wchar_t));
+		result.resize(this->decrypt_blocks(qpl::as_bytes(message), key, result, remove_null_terminations) / sizeof(wchar_t));
+		return result;
 	}
 	std::string qpl::AES::decrypted(const std::vector<char>& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.data()), message.size(), key, remove_null_terminations);
-		return std::string(std::move(reinterpret_cast<const char*>(s.data())), s.size());
+		std::string result;
+		result.resize(qpl::AES::encrypted_size(message.size()));
+		result.resize(this->decrypt_blocks(qpl::as_bytes(message), key, result, remove_null_terminations));
+		return result;
 	}
 	std::wstring qpl::AES::decrypted(const std::vector<wchar_t>& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.data()), message.size() * (sizeof(wchar_t) / sizeof(char)), key, remove_null_terminations);
-		return std::wstring(std::move(reinterpret_cast<const wchar_t*>(s.data())), s.size() / (sizeof(wchar_t) / sizeof(char)));
+		std::wstring result;
+		result.resize(qpl::AES::encrypted_size(message.size() * sizeof(wchar_t)) / sizeof(wchar_t));
+		result.resize(this->decrypt_blocks(qpl::as_bytes(message), key, result, remove_null_terminations) / sizeof(wchar_t));
+		return result;
 	}
 
 	void qpl::AES::decrypt(std::string& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.size(), key, remove_null_terminations);
-		qpl::container_memory_to_string(s, message);
+		auto size = message.size();
+		message.resize(qpl::AES::encrypted_size(size));
+		message.resize(this->decrypt_blocks(qpl::as_bytes(message).first(size), key, message, remove_null_terminations));
 	}
 	void qpl::AES::decrypt(std::wstring& message, const std::string& key, bool remove_null_terminations) {
-		auto s = qpl::AES::decrypted(reinterpret_cast<const qpl::u8*>(message.c_str()), message.size()* (sizeof(wchar_t) / sizeof(char)), key, remove_null_terminations);
-		qpl::container_memory_to_wstring(s, message);
+		auto size = message.size() * sizeof(wchar_t);
+		message.resize(qpl::AES::encrypted_size(size) / sizeof(wchar_t));
+		message.resize(this->decrypt_blocks(qpl::as_bytes(message).first(size), key, message, remove_null_terminations) / sizeof(wchar_t));
 	}
 
 
@@ -3,11 +3,67 @@
 #include <qpl/type_traits.hpp>
 #include <qpl/system.hpp>
 #include <qpl/time.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#endif
+
+#if defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)
+#include <immintrin.h>
+#endif
 
 namespace qpl {
 
     namespace filesys {
 
+        namespace detail {
+            //reads into a string instead of mapping, a file that shrinks meanwhile (e.g. a rotated log) just gives a shorter result
+            std::string read_whole_file(const std::string& path) {
+                std::ifstream file(path, std::ios::binary);
+                if (!file.is_open()) {
+                    throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+                }
+                std::error_code error;
+                auto size = std::filesystem::file_size(path, error);
+
+                std::string result(error ? 0u : static_cast<qpl::size>(size), '\0');
+                file.read(result.data(), static_cast<std::streamsize>(result.size()));
+                result.resize(static_cast<qpl::size>(file.gcount()));
+
+                //the file may also have grown
+                char buffer[1 << 12];
+                while (file.read(buffer, sizeof(buffer)) || file.gcount()) {
+                    result.append(buffer, static_cast<qpl::size>(file.gcount()));
+                }
+                return result;
+            }
+        }
+
         qpl::filesys::path& qpl::filesys::path::operator=(const qpl::string_view& str) {
             this->m_string.clear();
 
@@ -40,6 +96,7 @@ namespace qpl {
             this->m_string = other.m_string;
             this->m_is_file = other.m_is_file;
             this->m_is_directory = other.m_is_directory;
+            this->m_exists = other.m_exists;
             this->m_update = other.m_update;
             return *this;
         }
@@ -51,10 +108,26 @@ namespace qpl {
                 }
             }
 
-            this->m_is_file = entry.is_regular_file() || entry.is_block_file() || entry.is_character_file();
-            this->m_is_directory = entry.is_directory();
-            this->m_exists = entry.exists();
-            this->m_update = false;
+            //the iterator caches the entry's type (d_type on posix) and the is_* queries use it, while status() always stats.
+            //so only symlinks and less common types fall through to a stat
+            std::error_code error;
+            if (!entry.is_symlink(error) && !error) {
+                if (entry.is_regular_file(error)) {
+                    this->apply_status(std::filesystem::file_status(std::filesystem::file_type::regular));
+                    return *this;
+                }
+                if (entry.is_directory(error)) {
+                    this->apply_status(std::filesystem::file_status(std::filesystem::file_type::directory));
+                    return *this;
+                }
+            }
+            this->apply_status(entry.status(error));
+
+            //a listed entry that doesn't resolve (e.g. a dangling symlink) is neither, the trailing '/' guess is only for typed in paths
+            if (!this->m_exists) {
+                this->m_is_file = false;
+                this->m_is_directory = false;
+            }
             return *this;
         }
 
@@ -71,12 +144,38 @@ namespace qpl {
             return qpl::string_equals_ignore_case(name1, name2);
         }
         bool qpl::filesys::path::file_content_equals(const path& other) const {
-            if (this->is_file() && other.is_file()) {
-                auto str1 = this->read();
-                auto str2 = other.read();
-                return str1 == str2;
+            if (!this->is_file() || !other.is_file()) {
+                return false;
+            }
+            std::error_code error1, error2;
+            auto size1 = std::filesystem::file_size(this->m_string, error1);
+            auto size2 = std::filesystem::file_size(other.m_string, error2);
+            if (error1 || error2 || size1 != size2) {
+                return false;
+            }
+
+            std::ifstream file1(this->m_string, std::ios::binary);
+            std::ifstream file2(other.m_string, std::ios::binary);
+            if (!file1.is_open() || !file2.is_open()) {
+                return false;
+            }
+
+            //compare chunk by chunk and stop at the first difference
+            constexpr qpl::size chunk_size = qpl::size{ 1 } << 16;
+            std::vector<char> buffer1(chunk_size);
+            std::vector<char> buffer2(chunk_size);
+            while (true) {
+                file1.read(buffer1.data(), static_cast<std::streamsize>(chunk_size));
+                file2.read(buffer2.data(), static_cast<std::streamsize>(chunk_size));
+                auto read1 = file1.gcount();
+                auto read2 = file2.gcount();
+                if (read1 != read2 || std::memcmp(buffer1.data(), buffer2.data(), static_cast<qpl::size>(read1))) {
+                    return false;
+                }
+                if (!read1) {
+                    return true;
+                }
             }
-            return false;
         }
 
         qpl::filesys::path qpl::filesys::path::current_path() {
@@ -118,22 +217,7 @@ namespace qpl {
             if (this->empty()) {
                 return "";
             }
-            std::ifstream file(this->string(), std::ios::ate | std::ios::binary);
-
-            if (!file.is_open()) {
-                throw std::runtime_error("failed to open file!");
-            }
-
-            size_t fileSize = (size_t)file.tellg();
-            std::string buffer;
-            buffer.resize(fileSize);
-
-            file.seekg(0);
-            file.read(buffer.data(), fileSize);
-
-            file.close();
-
-            return buffer;
+            return detail::read_whole_file(this->m_string);
         }
         std::filesystem::file_time_type qpl::filesys::path::last_write_time() const {
             return std::filesystem::last_write_time(this->string());
@@ -596,8 +680,8 @@ namespace qpl {
         qpl::filesys::paths qpl::filesys::path::list_current_directory() const {
             qpl::filesys::paths list;
             auto str = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::directory_iterator(str, std::filesystem::directory_options::skip_permission_denied)) {
-                list.push_back({ i.path().string() });
+            for (auto& i : std::filesystem::directory_iterator(str, std::filesystem::directory_options::skip_permission_denied)) {
+                list.push_back(i);
             }
             return { list };
         }
@@ -605,12 +689,8 @@ namespace qpl {
             if (!this->exists_system()) {
                 return {};
             }
-            qpl::filesys::paths list;
             auto str = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(str, std::filesystem::directory_options::skip_permission_denied)) {
-                list.push_back({ i.path().string() });
-            }
-            return { list };
+            return qpl::filesys::walk(str);
         }
         void qpl::filesys::path::print_current_directory() const {
             auto list = this->list_current_directory();
@@ -1001,15 +1081,10 @@ namespace qpl {
 
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_equals(const qpl::string_view& extension) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.extension_equals(extension)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.extension_equals(extension);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_equals(const char* extension) const {
             return this->search_recursively_where_extension_equals(qpl::string_view{ extension });
@@ -1018,15 +1093,10 @@ namespace qpl {
             return this->search_recursively_where_extension_equals(qpl::string_view{ extension });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_contains(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.extension_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.extension_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_contains(const char* str) const {
             return this->search_recursively_where_extension_contains(qpl::string_view{ str });
@@ -1035,27 +1105,17 @@ namespace qpl {
             return this->search_recursively_where_extension_contains(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_matches(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.extension_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.extension_matches(regex);
+            });
         }
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_equals(const qpl::string_view& name) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.name_equals(name)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.name_equals(name);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_equals(const char* name) const {
             return this->search_recursively_where_name_equals(qpl::string_view{ name });
@@ -1064,15 +1124,10 @@ namespace qpl {
             return this->search_recursively_where_name_equals(qpl::string_view{ name });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_contains(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.name_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.name_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_contains(const char* str) const {
             return this->search_recursively_where_name_contains(qpl::string_view{ str });
@@ -1081,27 +1136,17 @@ namespace qpl {
             return this->search_recursively_where_name_contains(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_matches(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.name_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.name_matches(regex);
+            });
         }
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_equals(const qpl::string_view& file_name) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.file_name_equals(file_name)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.file_name_equals(file_name);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_equals(const char* file_name) const {
             return this->search_recursively_where_file_name_equals(qpl::string_view{ file_name });
@@ -1110,15 +1155,10 @@ namespace qpl {
             return this->search_recursively_where_file_name_equals(qpl::string_view{ file_name });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_contains(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.file_name_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.file_name_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_contains(const char* str) const {
             return this->search_recursively_where_file_name_contains(qpl::string_view{ str });
@@ -1127,27 +1167,17 @@ namespace qpl {
             return this->search_recursively_where_file_name_contains(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_matches(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.file_name_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.file_name_matches(regex);
+            });
         }
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_doesnt_equal(const qpl::string_view& extension) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.extension_equals(extension)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.extension_equals(extension);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_doesnt_equal(const char* extension) const {
             return this->search_recursively_where_extension_doesnt_equal(qpl::string_view{ extension });
@@ -1156,15 +1186,10 @@ namespace qpl {
             return this->search_recursively_where_extension_doesnt_equal(qpl::string_view{ extension });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_doesnt_contain(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.extension_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.extension_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_doesnt_contain(const char* str) const {
             return this->search_recursively_where_extension_doesnt_contain(qpl::string_view{ str });
@@ -1173,27 +1198,17 @@ namespace qpl {
             return this->search_recursively_where_extension_doesnt_contain(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_extension_doesnt_match(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.extension_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.extension_matches(regex);
+            });
         }
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_doesnt_equal(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.name_equals(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.name_equals(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_doesnt_equal(const char* str) const {
             return this->search_recursively_where_name_doesnt_equal(qpl::string_view{ str });
@@ -1202,15 +1217,10 @@ namespace qpl {
             return this->search_recursively_where_name_doesnt_equal(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_doesnt_contain(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.name_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.name_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_doesnt_contain(const char* str) const {
             return this->search_recursively_where_name_doesnt_contain(qpl::string_view{ str });
@@ -1219,27 +1229,17 @@ namespace qpl {
             return this->search_recursively_where_name_doesnt_contain(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_name_doesnt_match(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.name_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.name_matches(regex);
+            });
         }
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_doesnt_equal(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.file_name_equals(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.file_name_equals(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_doesnt_equal(const char* str) const {
             return this->search_recursively_where_file_name_doesnt_equal(qpl::string_view{ str });
@@ -1248,15 +1248,10 @@ namespace qpl {
             return this->search_recursively_where_file_name_doesnt_equal(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_doesnt_contain(const qpl::string_view& str) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.file_name_contains(str)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.file_name_contains(str);
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_doesnt_contain(const char* str) const {
             return this->search_recursively_where_file_name_doesnt_contain(qpl::string_view{ str });
@@ -1265,316 +1260,673 @@ namespace qpl {
             return this->search_recursively_where_file_name_doesnt_contain(qpl::string_view{ str });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_where_file_name_doesnt_match(const std::regex& regex) const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (!path.file_name_matches(regex)) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return !path.file_name_matches(regex);
+            });
         }
 
 
         qpl::filesys::paths qpl::filesys::path::search_recursively_directories() const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.is_directory()) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.is_directory();
+            });
         }
         qpl::filesys::paths qpl::filesys::path::search_recursively_files() const {
-            qpl::filesys::paths result;
             auto directory = this->is_directory() ? this->string() : this->get_parent_branch().string();
-            for (auto i : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied)) {
-                qpl::filesys::path path = i;
-                if (path.is_file()) {
-                    result.emplace_back(path);
-                }
-            }
-            return result;
+            return qpl::filesys::walk(directory, [&](const qpl::filesys::path& path) {
+                return path.is_file();
+            });
         }
 
         void qpl::filesys::path::construct() {
             this->m_is_file = false;
+            this->m_is_directory = false;
+            this->m_exists = false;
             this->m_string = "";
             this->m_update = true;
         }
         void qpl::filesys::path::check_update() const {
             if (this->m_update) {
-                this->m_exists = std::filesystem::exists(this->string());
-
                 if (this->empty()) {
+                    this->m_exists = false;
                     this->m_is_file = false;
                     this->m_is_directory = false;
+                    this->m_update = false;
+                    return;
                 }
-                else if (!this->m_exists) {
-                    this->m_is_file = this->m_string.back() != '/';
-                    this->m_is_directory = !this->m_is_file;
-                }
-                else {
-                    this->m_is_directory = std::filesystem::is_directory(this->string());
-                    this->m_is_file = this->m_is_directory ? false : std::filesystem::is_regular_file(this->string()) || std::filesystem::is_block_file(this->string()) || std::filesystem::is_character_file(this->string());
-                }
-                this->m_update = false;
+                std::error_code error;
+                this->apply_status(std::filesystem::status(this->m_string, error));
+            }
+        }
+        void qpl::filesys::path::apply_status(const std::filesystem::file_status& status) const {
+            this->m_exists = std::filesystem::exists(status);
+
+            if (this->empty()) {
+                this->m_is_file = false;
+                this->m_is_directory = false;
+            }
+            else if (!this->m_exists) {
+                this->m_is_file = this->m_string.back() != '/';
+                this->m_is_directory = !this->m_is_file;
+            }
+            else {
+                this->m_is_directory = std::filesystem::is_directory(status);
+                this->m_is_file = !this->m_is_directory && (std::filesystem::is_regular_file(status) || std::filesystem::is_block_file(status) || std::filesystem::is_character_file(status));
             }
+            this->m_update = false;
         }
 
         std::ostream& qpl::filesys::operator<<(std::ostream& os, const qpl::filesys::path& path) {
             return os << path.string();
         }
 
+        namespace detail {
+            //runs job(index, buffer) for every index on up to thread_count threads, every thread owns one buffer.
+            //the first exception stops the remaining jobs and is rethrown after all threads finished
+            template<typename F>
+            void parallel_jobs(qpl::size count, qpl::size thread_count, F&& job) {
+                if (!count) {
+                    return;
+                }
+                thread_count = qpl::max(qpl::min(thread_count ? thread_count : std::thread::hardware_concurrency(), count), qpl::size{ 1 });
 
+                std::atomic<qpl::size> next = 0u;
+                std::atomic<bool> failed = false;
+                std::exception_ptr exception;
+                std::mutex exception_mutex;
 
+                auto work = [&]() {
+                    std::vector<char> buffer;
+                    while (!failed.load(std::memory_order_relaxed)) {
+                        auto index = next.fetch_add(1u, std::memory_order_relaxed);
+                        if (index >= count) {
+                            return;
+                        }
+                        try {
+                            job(index, buffer);
+                        }
+                        catch (...) {
+                            std::lock_guard lock(exception_mutex);
+                            if (!exception) {
+                                exception = std::current_exception();
+                            }
+                            failed = true;
+                            return;
+                        }
+                    }
+                };
 
-        qpl::filesys::paths& qpl::filesys::paths::operator=(const std::vector<qpl::filesys::path>& paths) {
-            this->m_paths = paths;
-            return *this;
-        }
-        qpl::filesys::paths& qpl::filesys::paths::operator=(const qpl::filesys::paths& paths) {
-            this->m_paths = paths.m_paths;
-            return *this;
-        }
-
-        std::vector<qpl::filesys::path>::iterator qpl::filesys::paths::begin() {
-            return this->m_paths.begin();
-        }
-        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::begin() const {
-            return this->m_paths.cbegin();
-        }
-        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::cbegin() const {
-            return this->m_paths.cbegin();
-        }
-        std::vector<qpl::filesys::path>::reverse_iterator qpl::filesys::paths::rbegin() {
-            return this->m_paths.rbegin();
-        }
-        std::vector<qpl::filesys::path>::iterator qpl::filesys::paths::end() {
-            return this->m_paths.end();
-        }
-        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::end() const {
-            return this->m_paths.cend();
-        }
-        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::cend() const {
-            return this->m_paths.cend();
-        }
-        std::vector<qpl::filesys::path>::reverse_iterator qpl::filesys::paths::rend() {
-            return this->m_paths.rend();
-        }
-
-        void qpl::filesys::paths::copy_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
+                std::vector<std::thread> threads;
+                threads.reserve(thread_count - 1);
+                for (qpl::size i = 1u; i < thread_count; ++i) {
+                    threads.emplace_back(work);
+                }
+                work();
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                if (exception) {
+                    std::rethrow_exception(exception);
                 }
             }
 
-            for (auto& i : this->m_paths) {
-                std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::recursive);
-            }
-        }
-        void qpl::filesys::paths::move_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
+            struct walk_node {
+                std::vector<qpl::filesys::path> results;
+
+                //position in results where the subdirectory's own results belong
+                std::vector<std::pair<qpl::size, std::unique_ptr<walk_node>>> children;
+            };
+            struct walk_task {
+                std::filesystem::path directory;
+                walk_node* node;
+            };
+
+            void walk_directory(const walk_task& task, const std::function<bool(const qpl::filesys::path&)>& predicate, const qpl::filesys::walk_options& options, std::vector<walk_task>& found) {
+                std::error_code error;
+                std::filesystem::directory_iterator it(task.directory, std::filesystem::directory_options::skip_permission_denied, error);
+                for (; !error && it != std::filesystem::directory_iterator{}; it.increment(error)) {
+                    const auto& entry = *it;
+                    qpl::filesys::path path = entry;
+
+                    std::error_code symlink_error;
+                    bool recurse = path.is_directory() && !entry.is_symlink(symlink_error);
+
+                    if (!predicate || predicate(path)) {
+                        task.node->results.emplace_back(std::move(path));
+                    }
+                    if (recurse) {
+                        auto& child = task.node->children.emplace_back(task.node->results.size(), std::make_unique<walk_node>());
+                        found.push_back({ entry.path(), child.second.get() });
+                    }
+                }
+                if (error) {
+                    if (!options.on_error) {
+                        throw std::filesystem::filesystem_error("qpl::filesys::walk: can't read directory", task.directory, error);
+                    }
+                    options.on_error(task.directory.string(), error);
+                }
+            }
+            void walk_flatten_ordered(walk_node& node, std::vector<qpl::filesys::path>& result) {
+                qpl::size index = 0u;
+                for (auto& child : node.children) {
+                    std::move(node.results.begin() + index, node.results.begin() + child.first, std::back_inserter(result));
+                    index = child.first;
+                    walk_flatten_ordered(*child.second, result);
+                }
+                std::move(node.results.begin() + index, node.results.end(), std::back_inserter(result));
+            }
+            void walk_flatten_unordered(walk_node& root, std::vector<qpl::filesys::path>& result) {
+                std::vector<walk_node*> stack = { &root };
+                while (!stack.empty()) {
+                    auto node = stack.back();
+                    stack.pop_back();
+                    std::move(node->results.begin(), node->results.end(), std::back_inserter(result));
+                    for (auto& child : node->children) {
+                        stack.push_back(child.second.get());
+                    }
                 }
             }
+        }
 
-            for (auto& i : this->m_paths) {
-                std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::recursive);
-                i.remove();
-            }
-        }
-        void qpl::filesys::paths::copy_overwrite_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
+        qpl::filesys::paths qpl::filesys::walk(const qpl::filesys::path& root, const std::function<bool(const qpl::filesys::path&)>& predicate, const qpl::filesys::walk_options& options) {
+            if (root.empty() || !root.exists_system()) {
+                return {};
             }
 
-            for (auto& i : this->m_paths) {
-                std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-            }
-        }
-        void qpl::filesys::paths::move_overwrite_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
-            }
+            qpl::size thread_count = options.threads ? options.threads : std::thread::hardware_concurrency();
+            thread_count = qpl::max(thread_count, qpl::size{ 1 });
+
+            detail::walk_node tree;
+            std::deque<detail::walk_task> tasks;
+            tasks.push_back({ std::filesystem::path(root.string()), &tree });
+
+            //directory scans dominate, so one shared queue is enough. idle workers sleep on the condition variable,
+            //the walk is done once the queue is empty and nobody is scanning anymore
+            std::mutex mutex;
+            std::condition_variable condition;
+            qpl::size active = 0u;
+            qpl::size idle = 0u;
+            bool failed = false;
+            std::exception_ptr exception;
+            std::vector<std::thread> threads;
+
+            std::function<void()> work;
+            work = [&]() {
+                std::vector<detail::walk_task> found;
+                std::unique_lock lock(mutex);
+                while (!failed) {
+                    if (tasks.empty()) {
+                        if (!active) {
+                            condition.notify_all();
+                            return;
+                        }
+                        ++idle;
+                        condition.wait(lock);
+                        --idle;
+                        continue;
+                    }
 
-            for (auto& i : this->m_paths) {
-                std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-                i.remove();
-            }
-        }
+                    auto task = std::move(tasks.back());
+                    tasks.pop_back();
+                    ++active;
+                    lock.unlock();
 
-        void qpl::filesys::paths::copy_files_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
-            }
+                    found.clear();
+                    try {
+                        detail::walk_directory(task, predicate, options, found);
+                    }
+                    catch (...) {
+                        lock.lock();
+                        if (!exception) {
+                            exception = std::current_exception();
+                        }
+                        failed = true;
+                        --active;
+                        condition.notify_all();
+                        return;
+                    }
 
-            for (auto& i : this->m_paths) {
-                if (i.is_file()) {
-                    std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::recursive);
+                    lock.lock();
+                    --active;
+                    for (auto it = found.rbegin(); it != found.rend(); ++it) {
+                        tasks.push_back(std::move(*it));
+                    }
+                    if (tasks.size() > idle && threads.size() + 1 < thread_count) {
+                        try {
+                            threads.emplace_back(work);
+                        }
+                        catch (const std::system_error&) {
+                            //keep going with the threads we have
+                            thread_count = threads.size() + 1;
+                        }
+                    }
+                    if (idle && !tasks.empty()) {
+                        if (tasks.size() > 1u) {
+                            condition.notify_all();
+                        }
+                        else {
+                            condition.notify_one();
+                        }
+                    }
                 }
+                condition.notify_all();
+            };
+            work();
+
+            //threads are only started by a worker in the middle of a scan, so once nobody is active the list is complete
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [&]() {
+                    return !active;
+                });
             }
-        }
-        void qpl::filesys::paths::move_files_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
             }
 
-            for (auto& i : this->m_paths) {
-                if (i.is_file()) {
-                    std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::recursive);
-                    i.remove();
-                }
+            std::vector<qpl::filesys::path> result;
+            if (options.ordered) {
+                detail::walk_flatten_ordered(tree, result);
             }
-        }
-        void qpl::filesys::paths::copy_overwrite_files_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
+            else {
+                detail::walk_flatten_unordered(tree, result);
             }
+            return qpl::filesys::paths(std::move(result));
+        }
 
-            for (auto& i : this->m_paths) {
-                if (i.is_file()) {
-                    std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-                }
+
+
+
+        namespace detail {
+            char query_lower(char c) {
+                return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
             }
-        }
-        void qpl::filesys::paths::move_overwrite_files_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
+            bool query_equals(const qpl::string_view& str, const std::string& literal, bool ignore_case) {
+                if (!ignore_case) {
+                    return str == literal;
                 }
+                return str.size() == literal.size() && std::equal(str.begin(), str.end(), literal.begin(), [](char a, char b) {
+                    return query_lower(a) == b;
+                });
             }
-
-            for (auto& i : this->m_paths) {
-                if (i.is_file()) {
-                    std::filesystem::copy(i.string(), destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-                    i.remove();
+            bool query_contains(const qpl::string_view& str, const std::string& literal, bool ignore_case) {
+                if (!ignore_case) {
+                    return str.find(literal) != qpl::string_view::npos;
                 }
+                return std::search(str.begin(), str.end(), literal.begin(), literal.end(), [](char a, char b) {
+                    return query_lower(a) == b;
+                }) != str.end();
             }
         }
 
-        void qpl::filesys::paths::copy_as_tree_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
-                }
+        qpl::filesys::query& qpl::filesys::query::ignore_case(bool enable) {
+            this->m_ignore_case = enable;
+            for (auto& condition : this->m_conditions) {
+                this->prepare(condition);
             }
+            return *this;
+        }
+        qpl::filesys::query& qpl::filesys::query::files_only() {
+            this->m_files_only = true;
+            this->m_directories_only = false;
+            return *this;
+        }
+        qpl::filesys::query& qpl::filesys::query::directories_only() {
+            this->m_directories_only = true;
+            this->m_files_only = false;
+            return *this;
+        }
 
-            qpl::filesys::path tree_destination = destination;
-            auto levels = this->m_paths.front().branch_size() - 1;
-            qpl::u32 depth_ctr = levels;
-
-            for (auto& i : this->m_paths) {
+        qpl::filesys::query& qpl::filesys::query::extension_equals(const qpl::string_view& extension) {
+            return this->add_literals(field::extension, kind::equals, false, { extension });
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_in(std::initializer_list<qpl::string_view> extensions) {
+            return this->add_literals(field::extension, kind::equals, false, extensions);
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_contains(const qpl::string_view& str) {
+            return this->add_literals(field::extension, kind::contains, false, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_matches(const std::string& regex) {
+            return this->add_regex(field::extension, false, regex);
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_doesnt_equal(const qpl::string_view& extension) {
+            return this->add_literals(field::extension, kind::equals, true, { extension });
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_not_in(std::initializer_list<qpl::string_view> extensions) {
+            return this->add_literals(field::extension, kind::equals, true, extensions);
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_doesnt_contain(const qpl::string_view& str) {
+            return this->add_literals(field::extension, kind::contains, true, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::extension_doesnt_match(const std::string& regex) {
+            return this->add_regex(field::extension, true, regex);
+        }
 
-                auto branch_size = i.branch_size();
+        qpl::filesys::query& qpl::filesys::query::name_equals(const qpl::string_view& name) {
+            return this->add_literals(field::name, kind::equals, false, { name });
+        }
+        qpl::filesys::query& qpl::filesys::query::name_in(std::initializer_list<qpl::string_view> names) {
+            return this->add_literals(field::name, kind::equals, false, names);
+        }
+        qpl::filesys::query& qpl::filesys::query::name_contains(const qpl::string_view& str) {
+            return this->add_literals(field::name, kind::contains, false, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::name_matches(const std::string& regex) {
+            return this->add_regex(field::name, false, regex);
+        }
+        qpl::filesys::query& qpl::filesys::query::name_doesnt_equal(const qpl::string_view& name) {
+            return this->add_literals(field::name, kind::equals, true, { name });
+        }
+        qpl::filesys::query& qpl::filesys::query::name_not_in(std::initializer_list<qpl::string_view> names) {
+            return this->add_literals(field::name, kind::equals, true, names);
+        }
+        qpl::filesys::query& qpl::filesys::query::name_doesnt_contain(const qpl::string_view& str) {
+            return this->add_literals(field::name, kind::contains, true, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::name_doesnt_match(const std::string& regex) {
+            return this->add_regex(field::name, true, regex);
+        }
 
-                if (depth_ctr != branch_size) {
-                    tree_destination = destination;
-                    depth_ctr = levels;
-                    for (qpl::u32 l = levels; l < i.branch_size(); ++l) {
-                        tree_destination.go_into(i.branch_at(l).get_name());
-                        ++depth_ctr;
-                    }
-                }
+        qpl::filesys::query& qpl::filesys::query::file_name_equals(const qpl::string_view& file_name) {
+            return this->add_literals(field::file_name, kind::equals, false, { file_name });
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_in(std::initializer_list<qpl::string_view> file_names) {
+            return this->add_literals(field::file_name, kind::equals, false, file_names);
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_contains(const qpl::string_view& str) {
+            return this->add_literals(field::file_name, kind::contains, false, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_matches(const std::string& regex) {
+            return this->add_regex(field::file_name, false, regex);
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_doesnt_equal(const qpl::string_view& file_name) {
+            return this->add_literals(field::file_name, kind::equals, true, { file_name });
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_not_in(std::initializer_list<qpl::string_view> file_names) {
+            return this->add_literals(field::file_name, kind::equals, true, file_names);
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_doesnt_contain(const qpl::string_view& str) {
+            return this->add_literals(field::file_name, kind::contains, true, { str });
+        }
+        qpl::filesys::query& qpl::filesys::query::file_name_doesnt_match(const std::string& regex) {
+            return this->add_regex(field::file_name, true, regex);
+        }
 
+        qpl::filesys::query& qpl::filesys::query::size_greater(qpl::u64 bytes) {
+            condition condition{};
+            condition.target = field::size;
+            condition.type = kind::greater;
+            condition.bytes = bytes;
+            return this->add(std::move(condition));
+        }
+        qpl::filesys::query& qpl::filesys::query::size_less(qpl::u64 bytes) {
+            condition condition{};
+            condition.target = field::size;
+            condition.type = kind::less;
+            condition.bytes = bytes;
+            return this->add(std::move(condition));
+        }
+        qpl::filesys::query& qpl::filesys::query::where(const std::function<bool(const qpl::filesys::path&)>& check) {
+            condition condition{};
+            condition.target = field::custom;
+            condition.check = check;
+            return this->add(std::move(condition));
+        }
 
-                if (i.is_directory()) {
-                    tree_destination.create();
-                }
-                else if (i.is_file()) {
-                    std::filesystem::copy(i.string(), tree_destination.string(), std::filesystem::copy_options::recursive);
+        bool qpl::filesys::query::matches(const qpl::filesys::path& path) const {
+            if (this->m_files_only && !path.is_file()) {
+                return false;
+            }
+            if (this->m_directories_only && !path.is_directory()) {
+                return false;
+            }
+            for (auto& condition : this->m_conditions) {
+                if (!this->test(condition, path)) {
+                    return false;
                 }
             }
+            return true;
         }
-        void qpl::filesys::paths::move_as_tree_to(qpl::filesys::path destination) {
-            if (destination.is_directory()) {
-                if (!destination.exists()) {
-                    destination.create();
+        qpl::filesys::paths qpl::filesys::query::search(const qpl::filesys::path& directory) const {
+            std::vector<qpl::filesys::path> result;
+            auto str = directory.is_directory() ? directory.string() : directory.get_parent_branch().string();
+            for (auto& i : std::filesystem::directory_iterator(str, std::filesystem::directory_options::skip_permission_denied)) {
+                qpl::filesys::path path = i;
+                if (this->matches(path)) {
+                    result.emplace_back(std::move(path));
+                }
+            }
+            return qpl::filesys::paths(std::move(result));
+        }
+        qpl::filesys::paths qpl::filesys::query::search_recursively(const qpl::filesys::path& directory, const qpl::filesys::walk_options& options) const {
+            auto str = directory.is_directory() ? directory.string() : directory.get_parent_branch().string();
+            return qpl::filesys::walk(str, [&](const qpl::filesys::path& path) {
+                return this->matches(path);
+            }, options);
+        }
+
+        qpl::filesys::query& qpl::filesys::query::add_literals(field target, kind type, bool negate, std::initializer_list<qpl::string_view> literals) {
+            condition condition{};
+            condition.target = target;
+            condition.type = type;
+            condition.negate = negate;
+            for (auto& literal : literals) {
+                condition.literals.emplace_back(literal);
+            }
+            return this->add(std::move(condition));
+        }
+        qpl::filesys::query& qpl::filesys::query::add_regex(field target, bool negate, const std::string& regex) {
+            condition condition{};
+            condition.target = target;
+            condition.type = kind::matches;
+            condition.negate = negate;
+            condition.literals.push_back(regex);
+            return this->add(std::move(condition));
+        }
+        qpl::filesys::query& qpl::filesys::query::add(condition&& condition) {
+            this->prepare(condition);
+            auto cost = qpl::filesys::query::cost(condition);
+            auto it = std::find_if(this->m_conditions.begin(), this->m_conditions.end(), [&](const auto& other) {
+                return qpl::filesys::query::cost(other) > cost;
+            });
+            this->m_conditions.insert(it, std::move(condition));
+            return *this;
+        }
+        qpl::size qpl::filesys::query::cost(const condition& condition) {
+            //string literals < regex < stat for the size < user callbacks
+            switch (condition.target) {
+            case field::size:
+                return 3u;
+            case field::custom:
+                return 4u;
+            default:
+                return condition.type == kind::matches ? 2u : condition.type == kind::contains ? 1u : 0u;
+            }
+        }
+        void qpl::filesys::query::prepare(condition& condition) const {
+            if (condition.type == kind::matches) {
+                auto flags = std::regex::ECMAScript | std::regex::optimize;
+                if (this->m_ignore_case) {
+                    flags |= std::regex::icase;
                 }
+                condition.regex = std::regex(condition.literals.front(), flags);
+                return;
             }
-
-            qpl::filesys::path tree_destination = destination;
-            auto levels = this->m_paths.front().branch_size() - 1;
-            qpl::u32 depth_ctr = levels;
-
-            for (auto& i : this->m_paths) {
-
-                auto branch_size = i.branch_size();
-
-                if (depth_ctr != branch_size) {
-                    tree_destination = destination;
-                    depth_ctr = levels;
-                    for (qpl::u32 l = levels; l < i.branch_size(); ++l) {
-                        tree_destination.go_into(i.branch_at(l).get_name());
-                        ++depth_ctr;
+            condition.prepared = condition.literals;
+            for (auto& literal : condition.prepared) {
+                if (condition.target == field::extension && !literal.empty() && literal.front() == '.') {
+                    literal.erase(literal.begin());
+                }
+                if (condition.target == field::name) {
+                    while (!literal.empty() && literal.front() == '/') {
+                        literal.erase(literal.begin());
+                    }
+                    while (!literal.empty() && literal.back() == '/') {
+                        literal.pop_back();
                     }
                 }
+                if (this->m_ignore_case) {
+                    for (auto& c : literal) {
+                        c = detail::query_lower(c);
+                    }
+                }
+            }
+        }
+        bool qpl::filesys::query::test(const condition& condition, const qpl::filesys::path& path) const {
+            bool result = false;
+            switch (condition.target) {
+            case field::size: {
+                if (!path.is_file()) {
+                    return false;
+                }
+                std::error_code error;
+                auto size = std::filesystem::file_size(path.string(), error);
+                if (error) {
+                    return false;
+                }
+                result = condition.type == kind::greater ? size > condition.bytes : size < condition.bytes;
+            } break;
+            case field::custom:
+                result = condition.check(path);
+                break;
+            default: {
+                qpl::string_view str;
+                if (condition.target == field::extension) {
+                    str = path.has_extension() ? path.get_extension_view() : qpl::string_view{};
+                }
+                else if (condition.target == field::name) {
+                    str = path.get_name_view();
+                }
+                else {
+                    str = path.get_file_name_view();
+                }
 
-
-                if (i.is_directory()) {
-                    tree_destination.create();
+                if (condition.type == kind::matches) {
+                    result = std::regex_match(str.begin(), str.end(), condition.regex);
                 }
-                else if (i.is_file()) {
-                    std::filesystem::copy(i.string(), tree_destination.string(), std::filesystem::copy_options::recursive);
-                    i.remove();
+                else {
+                    for (auto& literal : condition.prepared) {
+                        if (condition.type == kind::equals ? detail::query_equals(str, literal, this->m_ignore_case) : detail::query_contains(str, literal, this->m_ignore_case)) {
+                            result = true;
+                            break;
+                        }
+                    }
                 }
+            } break;
             }
+            return result != condition.negate;
         }
-        void qpl::filesys::paths::copy_overwrite_as_tree_to(qpl::filesys::path destination) {
+
+        qpl::filesys::paths& qpl::filesys::paths::operator=(const std::vector<qpl::filesys::path>& paths) {
+            this->m_paths = paths;
+            return *this;
+        }
+        qpl::filesys::paths& qpl::filesys::paths::operator=(std::vector<qpl::filesys::path>&& paths) {
+            this->m_paths = std::move(paths);
+            return *this;
+        }
+        qpl::filesys::paths& qpl::filesys::paths::operator=(const qpl::filesys::paths& paths) {
+            this->m_paths = paths.m_paths;
+            return *this;
+        }
+
+        std::vector<qpl::filesys::path>::iterator qpl::filesys::paths::begin() {
+            return this->m_paths.begin();
+        }
+        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::begin() const {
+            return this->m_paths.cbegin();
+        }
+        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::cbegin() const {
+            return this->m_paths.cbegin();
+        }
+        std::vector<qpl::filesys::path>::reverse_iterator qpl::filesys::paths::rbegin() {
+            return this->m_paths.rbegin();
+        }
+        std::vector<qpl::filesys::path>::iterator qpl::filesys::paths::end() {
+            return this->m_paths.end();
+        }
+        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::end() const {
+            return this->m_paths.cend();
+        }
+        std::vector<qpl::filesys::path>::const_iterator qpl::filesys::paths::cend() const {
+            return this->m_paths.cend();
+        }
+        std::vector<qpl::filesys::path>::reverse_iterator qpl::filesys::paths::rend() {
+            return this->m_paths.rend();
+        }
+
+        qpl::filesys::transfer_progress qpl::filesys::paths::transfer_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options) {
             if (destination.is_directory()) {
                 if (!destination.exists()) {
                     destination.create();
                 }
             }
 
-            qpl::filesys::path tree_destination = destination;
-            auto levels = this->m_paths.front().branch_size() - 1;
-            qpl::u32 depth_ctr = levels;
-
+            //directories are created in order up front, only the files are transferred in parallel
+            std::vector<qpl::filesys::transfer_job> jobs;
+            std::vector<qpl::filesys::path> directories;
+            std::filesystem::path target_root = destination.string();
             for (auto& i : this->m_paths) {
-
-                auto branch_size = i.branch_size();
-
-                if (depth_ctr != branch_size) {
-                    tree_destination = destination;
-                    depth_ctr = levels;
-                    for (qpl::u32 l = levels; l < i.branch_size(); ++l) {
-                        tree_destination.go_into(i.branch_at(l).get_name());
-                        ++depth_ctr;
+                if (i.is_file()) {
+                    if (destination.is_directory()) {
+                        jobs.push_back({ i, (target_root / std::string(i.get_name_view())).string() });
+                    }
+                    else {
+                        jobs.push_back({ i, destination });
                     }
                 }
+                else if (i.is_directory()) {
+                    std::filesystem::path root = i.string();
+                    for (auto& entry : qpl::filesys::walk(i)) {
+                        auto target = target_root / std::filesystem::path(entry.string()).lexically_relative(root);
+                        if (entry.is_directory()) {
+                            std::error_code error;
+                            std::filesystem::create_directories(target, error);
+                            if (error) {
+                                throw std::filesystem::filesystem_error("qpl::filesys::paths::transfer_to: can't create directory", target, error);
+                            }
+                        }
+                        else if (entry.is_file()) {
+                            jobs.push_back({ entry, target.string() });
+                        }
+                    }
+                    directories.push_back(i);
+                }
+            }
 
-
-                if (i.is_directory()) {
-                    tree_destination.create();
+            auto result = qpl::filesys::transfer_files(jobs, options);
+            if (options.move) {
+                for (auto& i : directories) {
+                    i.remove();
                 }
-                else if (i.is_file()) {
-                    std::filesystem::copy(i.string(), tree_destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
+            }
+            return result;
+        }
+        qpl::filesys::transfer_progress qpl::filesys::paths::transfer_files_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options) {
+            qpl::filesys::paths files;
+            for (auto& i : this->m_paths) {
+                if (i.is_file()) {
+                    files.push_back(i);
                 }
             }
+            return files.transfer_to(destination, options);
         }
-        void qpl::filesys::paths::move_overwrite_as_tree_to(qpl::filesys::path destination) {
+        qpl::filesys::transfer_progress qpl::filesys::paths::transfer_as_tree_to(qpl::filesys::path destination, const qpl::filesys::transfer_options& options) {
             if (destination.is_directory()) {
                 if (!destination.exists()) {
                     destination.create();
                 }
             }
+            if (this->m_paths.empty()) {
+                return {};
+            }
 
+            std::vector<qpl::filesys::transfer_job> jobs;
             qpl::filesys::path tree_destination = destination;
             auto levels = this->m_paths.front().branch_size() - 1;
             qpl::u32 depth_ctr = levels;
@@ -1594,13 +1946,78 @@ namespace qpl {
 
 
                 if (i.is_directory()) {
-                    tree_destination.create();
+                    std::error_code error;
+                    std::filesystem::create_directories(tree_destination.string(), error);
+                    if (error) {
+                        throw std::filesystem::filesystem_error("qpl::filesys::paths::transfer_as_tree_to: can't create directory", tree_destination.string(), error);
+                    }
                 }
                 else if (i.is_file()) {
-                    std::filesystem::copy(i.string(), tree_destination.string(), std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-                    i.remove();
+                    auto target = std::filesystem::path(tree_destination.string()) / std::string(i.get_name_view());
+                    jobs.push_back({ i, target.string() });
                 }
             }
+            return qpl::filesys::transfer_files(jobs, options);
+        }
+
+        void qpl::filesys::paths::copy_to(qpl::filesys::path destination) {
+            this->transfer_to(destination, {});
+        }
+        void qpl::filesys::paths::move_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.move = true;
+            this->transfer_to(destination, options);
+        }
+        void qpl::filesys::paths::copy_overwrite_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            this->transfer_to(destination, options);
+        }
+        void qpl::filesys::paths::move_overwrite_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            options.move = true;
+            this->transfer_to(destination, options);
+        }
+
+        void qpl::filesys::paths::copy_files_to(qpl::filesys::path destination) {
+            this->transfer_files_to(destination, {});
+        }
+        void qpl::filesys::paths::move_files_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.move = true;
+            this->transfer_files_to(destination, options);
+        }
+        void qpl::filesys::paths::copy_overwrite_files_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            this->transfer_files_to(destination, options);
+        }
+        void qpl::filesys::paths::move_overwrite_files_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            options.move = true;
+            this->transfer_files_to(destination, options);
+        }
+
+        void qpl::filesys::paths::copy_as_tree_to(qpl::filesys::path destination) {
+            this->transfer_as_tree_to(destination, {});
+        }
+        void qpl::filesys::paths::move_as_tree_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.move = true;
+            this->transfer_as_tree_to(destination, options);
+        }
+        void qpl::filesys::paths::copy_overwrite_as_tree_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            this->transfer_as_tree_to(destination, options);
+        }
+        void qpl::filesys::paths::move_overwrite_as_tree_to(qpl::filesys::path destination) {
+            qpl::filesys::transfer_options options;
+            options.overwrite = true;
+            options.move = true;
+            this->transfer_as_tree_to(destination, options);
         }
 
         qpl::size qpl::filesys::paths::size() const {
@@ -2347,50 +2764,590 @@ namespace qpl {
         void qpl::filesys::paths::list_recursively_add_where_file_name_doesnt_equal(const qpl::filesys::path& directory, const char* file_name) {
             this->list_recursively_add_where_file_name_doesnt_equal(directory, qpl::string_view{ file_name });
         }
-        void qpl::filesys::paths::list_keep_where_file_name_contains(const char* str) {
-            this->list_keep_where_file_name_contains(qpl::string_view{ str });
+        void qpl::filesys::paths::list_keep_where_file_name_contains(const char* str) {
+            this->list_keep_where_file_name_contains(qpl::string_view{ str });
+        }
+        void qpl::filesys::paths::list_add_where_file_name_doesnt_contain(const qpl::filesys::path& directory, const char* str) {
+            this->list_recursively_add_where_file_name_doesnt_contain(directory, qpl::string_view{ str });
+        }
+        void qpl::filesys::paths::list_recursively_add_where_file_name_doesnt_contain(const qpl::filesys::path& directory, const char* str) {
+            this->list_recursively_add_where_file_name_doesnt_contain(directory, qpl::string_view{ str });
+        }
+
+
+        qpl::filesys::mapped_file::mapped_file(mapped_file&& other) noexcept {
+            this->steal(other);
+        }
+        qpl::filesys::mapped_file& qpl::filesys::mapped_file::operator=(mapped_file&& other) noexcept {
+            if (this != &other) {
+                this->close();
+                this->steal(other);
+            }
+            return *this;
+        }
+        void qpl::filesys::mapped_file::steal(mapped_file& other) {
+            this->m_data = other.m_data;
+            this->m_size = other.m_size;
+            this->m_open = other.m_open;
+            other.m_data = nullptr;
+            other.m_size = 0u;
+            other.m_open = false;
+#ifdef _WIN32
+            this->m_file = other.m_file;
+            this->m_mapping = other.m_mapping;
+            other.m_file = nullptr;
+            other.m_mapping = nullptr;
+#else
+            this->m_descriptor = other.m_descriptor;
+            other.m_descriptor = -1;
+#endif
+        }
+
+        void qpl::filesys::mapped_file::open(const qpl::filesys::path& path) {
+            this->close();
+#ifdef _WIN32
+            //share everything like ifstream does, so files other processes are writing (logs, file_writer) can be opened
+            auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size)) {
+                CloseHandle(file);
+                throw std::runtime_error(qpl::to_string("failed to read size of file \"", path, "\"").c_str());
+            }
+            this->m_file = file;
+            this->m_size = static_cast<qpl::size>(size.QuadPart);
+            this->m_open = true;
+
+            //empty files can't be mapped, they are represented by an empty view
+            if (this->m_size) {
+                this->m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                auto data = this->m_mapping ? MapViewOfFile(this->m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if (!data) {
+                    this->close();
+                    throw std::runtime_error(qpl::to_string("failed to map file \"", path, "\"").c_str());
+                }
+                this->m_data = static_cast<const char*>(data);
+            }
+#else
+            auto descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor == -1) {
+                throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+            }
+            struct stat info;
+            if (::fstat(descriptor, &info) == -1) {
+                ::close(descriptor);
+                throw std::runtime_error(qpl::to_string("failed to read size of file \"", path, "\"").c_str());
+            }
+            this->m_descriptor = descriptor;
+            this->m_size = static_cast<qpl::size>(info.st_size);
+            this->m_open = true;
+
+            //empty files can't be mapped, they are represented by an empty view
+            if (this->m_size) {
+                auto data = ::mmap(nullptr, this->m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (data == MAP_FAILED) {
+                    this->close();
+                    throw std::runtime_error(qpl::to_string("failed to map file \"", path, "\"").c_str());
+                }
+                ::madvise(data, this->m_size, MADV_SEQUENTIAL);
+                this->m_data = static_cast<const char*>(data);
+            }
+#endif
+        }
+        void qpl::filesys::mapped_file::close() {
+#ifdef _WIN32
+            if (this->m_data) {
+                UnmapViewOfFile(this->m_data);
+            }
+            if (this->m_mapping) {
+                CloseHandle(this->m_mapping);
+            }
+            if (this->m_file) {
+                CloseHandle(this->m_file);
+            }
+            this->m_mapping = nullptr;
+            this->m_file = nullptr;
+#else
+            if (this->m_data) {
+                ::munmap(const_cast<char*>(this->m_data), this->m_size);
+            }
+            if (this->m_descriptor != -1) {
+                ::close(this->m_descriptor);
+            }
+            this->m_descriptor = -1;
+#endif
+            this->m_data = nullptr;
+            this->m_size = 0u;
+            this->m_open = false;
+        }
+
+        bool qpl::filesys::mapped_file::is_open() const {
+            return this->m_open;
+        }
+        bool qpl::filesys::mapped_file::empty() const {
+            return this->m_size == 0u;
+        }
+        qpl::size qpl::filesys::mapped_file::size() const {
+            return this->m_size;
+        }
+        const char* qpl::filesys::mapped_file::data() const {
+            return this->m_data;
+        }
+        qpl::string_view qpl::filesys::mapped_file::view() const {
+            return qpl::string_view(this->m_data, this->m_size);
+        }
+        qpl::span<const std::byte> qpl::filesys::mapped_file::bytes() const {
+            return qpl::span<const std::byte>(reinterpret_cast<const std::byte*>(this->m_data), this->m_size);
+        }
+
+        void qpl::filesys::file_writer::open(const qpl::filesys::path& path, qpl::size buffer_size, bool append) {
+            std::lock_guard thread_lock(this->m_thread_mutex);
+            this->close_file();
+
+            {
+                std::lock_guard lock(this->m_mutex);
+                //the writer does its own buffering, so the stream's buffer is disabled
+                this->m_file.rdbuf()->pubsetbuf(nullptr, 0);
+                this->m_file.open(path.string(), std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+                if (!this->m_file.good()) {
+                    throw std::runtime_error(qpl::to_string("qpl::filesys::file_writer: failed to open file \"", path, "\"").c_str());
+                }
+                this->m_buffer.resize(qpl::max(buffer_size, qpl::size{ 64 }));
+                this->m_used = 0u;
+                this->m_error = nullptr;
+            }
+            this->start_thread();
+        }
+        void qpl::filesys::file_writer::close() {
+            std::lock_guard thread_lock(this->m_thread_mutex);
+            this->close_file();
+        }
+        void qpl::filesys::file_writer::close_file() {
+            this->stop_thread();
+
+            std::lock_guard lock(this->m_mutex);
+            auto error = std::exchange(this->m_error, nullptr);
+            if (this->m_file.is_open()) {
+                try {
+                    this->write_buffer();
+                }
+                catch (...) {
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                this->m_file.close();
+            }
+            this->m_buffer.clear();
+            this->m_buffer.shrink_to_fit();
+            this->m_used = 0u;
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        bool qpl::filesys::file_writer::is_open() const {
+            std::lock_guard lock(this->m_mutex);
+            return this->m_file.is_open();
+        }
+
+        void qpl::filesys::file_writer::flush() {
+            std::lock_guard lock(this->m_mutex);
+            this->check_writable();
+            this->write_buffer();
+        }
+        void qpl::filesys::file_writer::set_flush_interval(double seconds) {
+            std::lock_guard thread_lock(this->m_thread_mutex);
+            this->stop_thread();
+            this->m_interval = qpl::max(seconds, 0.0);
+            if (this->is_open()) {
+                this->start_thread();
+            }
+        }
+        void qpl::filesys::file_writer::start_thread() {
+            if (this->m_interval <= 0.0) {
+                return;
+            }
+            auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(this->m_interval));
+            this->m_thread = std::thread([this, interval]() {
+                std::unique_lock lock(this->m_mutex);
+                while (!this->m_condition.wait_for(lock, interval, [&]() { return this->m_stop; })) {
+                    try {
+                        this->write_buffer();
+                    }
+                    catch (...) {
+                        this->m_error = std::current_exception();
+                        return;
+                    }
+                }
+            });
+        }
+        void qpl::filesys::file_writer::stop_thread() {
+            if (!this->m_thread.joinable()) {
+                return;
+            }
+            {
+                std::lock_guard lock(this->m_mutex);
+                this->m_stop = true;
+            }
+            this->m_condition.notify_all();
+            this->m_thread.join();
+            this->m_stop = false;
+        }
+
+        qpl::size qpl::filesys::file_writer::buffered() const {
+            std::lock_guard lock(this->m_mutex);
+            return this->m_used;
+        }
+        qpl::size qpl::filesys::file_writer::buffer_size() const {
+            std::lock_guard lock(this->m_mutex);
+            return this->m_buffer.size();
+        }
+
+        void qpl::filesys::file_writer::append_bytes(const char* data, qpl::size size) {
+            if (size > this->m_buffer.size() - this->m_used) {
+                this->write_buffer();
+                //too big to be worth buffering, goes straight to the file
+                if (size >= this->m_buffer.size()) {
+                    if (!this->m_file.write(data, static_cast<std::streamsize>(size))) {
+                        this->m_file.clear();
+                        throw std::runtime_error("qpl::filesys::file_writer: failed to write to file");
+                    }
+                    return;
+                }
+            }
+            std::memcpy(this->m_buffer.data() + this->m_used, data, size);
+            this->m_used += size;
+        }
+        void qpl::filesys::file_writer::write_buffer() {
+            if (this->m_used) {
+                this->m_file.write(this->m_buffer.data(), static_cast<std::streamsize>(this->m_used));
+                this->m_file.flush();
+                this->m_used = 0u;
+                if (!this->m_file.good()) {
+                    this->m_file.clear();
+                    throw std::runtime_error("qpl::filesys::file_writer: failed to write to file");
+                }
+            }
+        }
+        void qpl::filesys::file_writer::check_writable() {
+            if (this->m_error) {
+                std::rethrow_exception(std::exchange(this->m_error, nullptr));
+            }
+            if (!this->m_file.is_open()) {
+                throw std::runtime_error("qpl::filesys::file_writer: file is not open");
+            }
+        }
+
+        namespace detail {
+            constexpr qpl::size file_chunk_size = qpl::size{ 1 } << 20;
+
+            qpl::size count_newlines(const char* data, qpl::size size) {
+                qpl::size result = 0u;
+                qpl::size i = 0u;
+#if (defined(QPL_USE_INTRINSICS) || defined(QPL_USE_ALL)) && defined(__AVX2__)
+                const __m256i newline = _mm256_set1_epi8('\n');
+                for (; i + 32u <= size; i += 32u) {
+                    auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                    auto mask = static_cast<qpl::u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(value, newline)));
+                    result += std::popcount(mask);
+                }
+#endif
+                //8 bytes at a time: every '\n' becomes a zero byte, zero bytes are counted exactly
+                constexpr qpl::u64 newlines = 0x0a0a0a0a0a0a0a0aull;
+                constexpr qpl::u64 low_bits = 0x7f7f7f7f7f7f7f7full;
+                for (; i + 8u <= size; i += 8u) {
+                    qpl::u64 word;
+                    std::memcpy(&word, data + i, sizeof(word));
+                    word ^= newlines;
+                    auto zero = ~(((word & low_bits) + low_bits) | word | low_bits);
+                    result += std::popcount(zero);
+                }
+                for (; i < size; ++i) {
+                    result += (data[i] == '\n');
+                }
+                return result;
+            }
+
+            //streams a file in fixed chunks and yields a hash per line, same lines as std::getline
+            class line_hasher {
+            public:
+                line_hasher(const qpl::filesys::path& path) : m_file(path.string(), std::ios::binary), m_buffer(file_chunk_size) {
+                    if (!this->m_file.is_open()) {
+                        throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+                    }
+                }
+
+                //64 bit FNV-1a over the line without its '\n', together with the length
+                bool next(qpl::u64& hash, qpl::size& length) {
+                    hash = 0xcbf29ce484222325ull;
+                    length = 0u;
+                    bool any = false;
+                    while (true) {
+                        if (this->m_position == this->m_size && !this->fill()) {
+                            return any;
+                        }
+                        any = true;
+                        auto begin = this->m_buffer.data() + this->m_position;
+                        auto end = this->m_buffer.data() + this->m_size;
+                        auto newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+                        auto stop = newline ? newline : end;
+                        for (auto it = begin; it != stop; ++it) {
+                            hash = (hash ^ static_cast<qpl::u8>(*it)) * 0x100000001b3ull;
+                        }
+                        length += static_cast<qpl::size>(stop - begin);
+                        this->m_position = static_cast<qpl::size>(stop - this->m_buffer.data()) + (newline ? 1u : 0u);
+                        if (newline) {
+                            return true;
+                        }
+                    }
+                }
+
+            private:
+                bool fill() {
+                    this->m_file.read(this->m_buffer.data(), static_cast<std::streamsize>(this->m_buffer.size()));
+                    this->m_size = static_cast<qpl::size>(this->m_file.gcount());
+                    this->m_position = 0u;
+                    return this->m_size != 0u;
+                }
+
+                std::ifstream m_file;
+                std::vector<char> m_buffer;
+                qpl::size m_position = 0u;
+                qpl::size m_size = 0u;
+            };
+        }
+
+        bool qpl::filesys::file_content_equals(const qpl::filesys::path& path1, const qpl::filesys::path& path2) {
+            return path1.file_content_equals(path2);
+        }
+        namespace detail {
+            //streaming XXH64, seed 0
+            class xxhash64 {
+            public:
+                void update(const char* data, qpl::size size) {
+                    this->m_length += size;
+                    if (this->m_buffered + size < 32u) {
+                        std::memcpy(this->m_buffer + this->m_buffered, data, size);
+                        this->m_buffered += size;
+                        return;
+                    }
+                    if (this->m_buffered) {
+                        auto fill = 32u - this->m_buffered;
+                        std::memcpy(this->m_buffer + this->m_buffered, data, fill);
+                        this->consume(this->m_buffer);
+                        data += fill;
+                        size -= fill;
+                        this->m_buffered = 0u;
+                    }
+                    for (; size >= 32u; data += 32u, size -= 32u) {
+                        this->consume(data);
+                    }
+                    std::memcpy(this->m_buffer, data, size);
+                    this->m_buffered = size;
+                }
+                qpl::u64 digest() const {
+                    qpl::u64 hash;
+                    if (this->m_length >= 32u) {
+                        hash = std::rotl(this->m_lanes[0], 1) + std::rotl(this->m_lanes[1], 7) + std::rotl(this->m_lanes[2], 12) + std::rotl(this->m_lanes[3], 18);
+                        for (auto lane : this->m_lanes) {
+                            hash = (hash ^ round(0u, lane)) * prime1 + prime4;
+                        }
+                    }
+                    else {
+                        hash = prime5;
+                    }
+                    hash += this->m_length;
+
+                    qpl::size i = 0u;
+                    for (; i + 8u <= this->m_buffered; i += 8u) {
+                        hash = std::rotl(hash ^ round(0u, read64(this->m_buffer + i)), 27) * prime1 + prime4;
+                    }
+                    if (i + 4u <= this->m_buffered) {
+                        hash = std::rotl(hash ^ (read32(this->m_buffer + i) * prime1), 23) * prime2 + prime3;
+                        i += 4u;
+                    }
+                    for (; i < this->m_buffered; ++i) {
+                        hash = std::rotl(hash ^ (static_cast<qpl::u8>(this->m_buffer[i]) * prime5), 11) * prime1;
+                    }
+                    hash ^= hash >> 33;
+                    hash *= prime2;
+                    hash ^= hash >> 29;
+                    hash *= prime3;
+                    hash ^= hash >> 32;
+                    return hash;
+                }
+
+            private:
+                static constexpr qpl::u64 prime1 = 0x9E3779B185EBCA87ull;
+                static constexpr qpl::u64 prime2 = 0xC2B2AE3D27D4EB4Full;
+                static constexpr qpl::u64 prime3 = 0x165667B19E3779F9ull;
+                static constexpr qpl::u64 prime4 = 0x85EBCA77C2B2AE63ull;
+                static constexpr qpl::u64 prime5 = 0x27D4EB2F165667C5ull;
+
+                static qpl::u64 read64(const char* data) {
+                    qpl::u64 value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return value;
+                }
+                static qpl::u64 read32(const char* data) {
+                    qpl::u32 value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return value;
+                }
+                static qpl::u64 round(qpl::u64 lane, qpl::u64 input) {
+                    return std::rotl(lane + input * prime2, 31) * prime1;
+                }
+                void consume(const char* data) {
+                    for (qpl::size i = 0u; i < 4u; ++i) {
+                        this->m_lanes[i] = round(this->m_lanes[i], read64(data + i * 8u));
+                    }
+                }
+
+                qpl::u64 m_lanes[4] = { prime1 + prime2, prime2, 0u, 0u - prime1 };
+                char m_buffer[32];
+                qpl::size m_buffered = 0u;
+                qpl::u64 m_length = 0u;
+            };
+
+            void group_duplicates(std::vector<qpl::filesys::path>& candidates, std::vector<qpl::filesys::paths>& result) {
+                //candidates share size and hash, so nearly always one group. verifying guards against collisions
+                while (candidates.size() > 1u) {
+                    std::vector<qpl::filesys::path> group = { candidates.front() };
+                    std::vector<qpl::filesys::path> rest;
+                    for (qpl::size i = 1u; i < candidates.size(); ++i) {
+                        if (candidates.front().file_content_equals(candidates[i])) {
+                            group.push_back(candidates[i]);
+                        }
+                        else {
+                            rest.push_back(candidates[i]);
+                        }
+                    }
+                    if (group.size() > 1u) {
+                        result.emplace_back(std::move(group));
+                    }
+                    candidates = std::move(rest);
+                }
+            }
+            template<typename F>
+            std::vector<qpl::filesys::paths> find_duplicates(const qpl::filesys::paths& files, F&& hash) {
+                std::unordered_map<qpl::u64, std::vector<qpl::filesys::path>> sizes;
+                for (auto& file : files) {
+                    if (!file.is_file()) {
+                        continue;
+                    }
+                    std::error_code error;
+                    auto size = std::filesystem::file_size(file.string(), error);
+                    if (!error) {
+                        sizes[size].push_back(file);
+                    }
+                }
+
+                std::vector<qpl::filesys::paths> result;
+                for (auto& [size, same_size] : sizes) {
+                    if (same_size.size() < 2u) {
+                        continue;
+                    }
+                    std::unordered_map<qpl::u64, std::vector<qpl::filesys::path>> hashes;
+                    for (auto& file : same_size) {
+                        hashes[hash(file)].push_back(file);
+                    }
+                    for (auto& [value, same_hash] : hashes) {
+                        detail::group_duplicates(same_hash, result);
+                    }
+                }
+                return result;
+            }
+        }
+
+        qpl::u64 qpl::filesys::file_content_hash(const qpl::filesys::path& path) {
+            std::ifstream file(path.string(), std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+            }
+            std::vector<char> buffer(qpl::size{ 1 } << 16);
+            detail::xxhash64 hash;
+            while (file) {
+                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                hash.update(buffer.data(), static_cast<qpl::size>(file.gcount()));
+            }
+            return hash.digest();
+        }
+
+        qpl::u64 qpl::filesys::file_hash_cache::hash(const qpl::filesys::path& path) {
+            auto size = static_cast<qpl::u64>(std::filesystem::file_size(path.string()));
+            auto time = std::filesystem::last_write_time(path.string());
+
+            auto it = this->m_entries.find(path.string());
+            if (it != this->m_entries.end() && it->second.size == size && it->second.time == time) {
+                return it->second.hash;
+            }
+            auto hash = qpl::filesys::file_content_hash(path);
+            this->m_entries[path.string()] = entry{ size, time, hash };
+            return hash;
+        }
+        void qpl::filesys::file_hash_cache::erase(const qpl::filesys::path& path) {
+            this->m_entries.erase(path.string());
         }
-        void qpl::filesys::paths::list_add_where_file_name_doesnt_contain(const qpl::filesys::path& directory, const char* str) {
-            this->list_recursively_add_where_file_name_doesnt_contain(directory, qpl::string_view{ str });
+        void qpl::filesys::file_hash_cache::clear() {
+            this->m_entries.clear();
         }
-        void qpl::filesys::paths::list_recursively_add_where_file_name_doesnt_contain(const qpl::filesys::path& directory, const char* str) {
-            this->list_recursively_add_where_file_name_doesnt_contain(directory, qpl::string_view{ str });
+        qpl::size qpl::filesys::file_hash_cache::size() const {
+            return this->m_entries.size();
         }
 
-
-        bool qpl::filesys::file_content_equals(const qpl::filesys::path& path1, const qpl::filesys::path& path2) {
-            return path1.file_content_equals(path2);
+        std::vector<qpl::filesys::paths> qpl::filesys::find_duplicates(const qpl::filesys::paths& files) {
+            return detail::find_duplicates(files, [](const qpl::filesys::path& path) {
+                return qpl::filesys::file_content_hash(path);
+            });
         }
+        std::vector<qpl::filesys::paths> qpl::filesys::find_duplicates(const qpl::filesys::paths& files, qpl::filesys::file_hash_cache& cache) {
+            return detail::find_duplicates(files, [&](const qpl::filesys::path& path) {
+                return cache.hash(path);
+            });
+        }
+
         qpl::size qpl::filesys::file_lines(const qpl::filesys::path& path) {
-            std::stringstream str;
-            str << qpl::filesys::read_file(path).data();
+            std::ifstream file(path.string(), std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+            }
 
-            std::string line;
+            std::vector<char> buffer(detail::file_chunk_size);
             qpl::size ctr = 0u;
-            while (std::getline(str, line)) {
+            char last = '\n';
+            while (file) {
+                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                auto size = static_cast<qpl::size>(file.gcount());
+                if (!size) {
+                    break;
+                }
+                ctr += detail::count_newlines(buffer.data(), size);
+                last = buffer[size - 1];
+            }
+
+            //a last line without '\n' still counts, like std::getline
+            if (last != '\n') {
                 ++ctr;
             }
             return ctr;
         }
 
         qpl::size qpl::filesys::file_bytes(const qpl::filesys::path& path) {
-            std::stringstream str;
-            str << qpl::filesys::read_file(path).data();
-
-            return str.str().size();
+            return static_cast<qpl::size>(std::filesystem::file_size(path.string()));
         }
 
         std::vector<qpl::size> qpl::filesys::file_line_differences(const qpl::filesys::path& path1, const qpl::filesys::path& path2) {
             std::vector<qpl::size> result;
-            std::stringstream str1;
-            str1 << qpl::filesys::read_file(path1).data();
-            std::stringstream str2;
-            str2 << qpl::filesys::read_file(path2).data();
+            detail::line_hasher lines1(path1);
+            detail::line_hasher lines2(path2);
 
-            std::string line1, line2;
+            qpl::u64 hash1, hash2;
+            qpl::size length1, length2;
             qpl::size ctr = 0u;
-            while (std::getline(str1, line1) && std::getline(str2, line2)) {
-                if (line1 != line2) {
+            while (lines1.next(hash1, length1) && lines2.next(hash2, length2)) {
+                if (hash1 != hash2 || length1 != length2) {
                     result.push_back(ctr);
                 }
                 ++ctr;
@@ -2398,16 +3355,15 @@ namespace qpl {
             return result;
         }
         qpl::f64 qpl::filesys::file_lines_difference_percentage(const qpl::filesys::path& path1, const qpl::filesys::path& path2) {
-            std::stringstream str1;
-            str1 << qpl::filesys::read_file(path1).data();
-            std::stringstream str2;
-            str2 << qpl::filesys::read_file(path2).data();
+            detail::line_hasher lines1(path1);
+            detail::line_hasher lines2(path2);
 
-            std::string line1, line2;
+            qpl::u64 hash1, hash2;
+            qpl::size length1, length2;
             qpl::size ctr = 0u;
             qpl::size sum = 0u;
-            while (std::getline(str1, line1) && std::getline(str2, line2)) {
-                if (line1 != line2) {
+            while (lines1.next(hash1, length1) && lines2.next(hash2, length2)) {
+                if (hash1 != hash2 || length1 != length2) {
                     ++ctr;
                 }
                 ++sum;
@@ -2415,29 +3371,622 @@ namespace qpl {
             return static_cast<qpl::f64>(ctr) / sum;
         }
 
+        namespace detail {
+            //streams size bytes from the current position of in to the current position of out
+            void copy_stream(std::istream& in, std::ostream& out, qpl::u64 size, std::vector<char>& buffer, detail::xxhash64* hash) {
+                while (size) {
+                    auto chunk = static_cast<qpl::size>(qpl::min(size, static_cast<qpl::u64>(buffer.size())));
+                    in.read(buffer.data(), static_cast<std::streamsize>(chunk));
+                    if (static_cast<qpl::size>(in.gcount()) != chunk) {
+                        throw std::runtime_error("unexpected end of file");
+                    }
+                    if (hash) {
+                        hash->update(buffer.data(), chunk);
+                    }
+                    out.write(buffer.data(), static_cast<std::streamsize>(chunk));
+                    if (!out) {
+                        throw std::runtime_error("failed to write");
+                    }
+                    size -= chunk;
+                }
+            }
+        }
+
         void qpl::filesys::split_file(const qpl::filesys::path& path, qpl::u32 bytes) {
-            auto content = qpl::filesys::read_file(path);
-            auto splits = (content.size() - 1) / bytes + 1;
+            qpl::filesys::split_file(path, qpl::u64{ bytes }, qpl::filesys::split_options{});
+        }
+        std::vector<qpl::u64> qpl::filesys::split_file(const qpl::filesys::path& path, qpl::u64 bytes, const qpl::filesys::split_options& options) {
+            if (!bytes) {
+                throw std::runtime_error("qpl::filesys::split_file: bytes must be greater than 0");
+            }
+            auto size = static_cast<qpl::u64>(std::filesystem::file_size(path.string()));
+            auto splits = qpl::max((size + bytes - 1) / bytes, qpl::u64{ 1 });
+
+            std::vector<qpl::u64> checksums(options.checksums ? splits : 0u);
+
+            //every part is independent, so each thread reads its own range of the source
+            detail::parallel_jobs(splits, options.threads, [&](qpl::size i, std::vector<char>& buffer) {
+                buffer.resize(options.buffer_size);
 
-            for (int i = 0; i < splits; ++i) {
                 auto file_name = qpl::to_string(path.string(), ".PART", qpl::prepended_to_string_to_fit(i, '0', std::log(splits) / std::log(10) + 1));
+                std::ifstream source(path.string(), std::ios::binary);
                 std::ofstream file(file_name.c_str(), std::ios::binary);
+                if (!source.good()) {
+                    throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+                }
                 if (!file.good()) {
-                    qpl::println("there was a problem creating \"", file_name, "\"");
+                    throw std::runtime_error(qpl::to_string("there was a problem creating \"", file_name, "\"").c_str());
                 }
-                file << content.substr(i * bytes, bytes);
-                file.flush();
-            }
+
+                auto offset = i * bytes;
+                source.seekg(static_cast<std::streamoff>(offset));
+
+                detail::xxhash64 hash;
+                detail::copy_stream(source, file, qpl::min(bytes, size - offset), buffer, options.checksums ? &hash : nullptr);
+                file.close();
+                if (file.fail()) {
+                    throw std::runtime_error(qpl::to_string("there was a problem writing \"", file_name, "\"").c_str());
+                }
+                if (options.checksums) {
+                    checksums[i] = hash.digest();
+                }
+            });
+            return checksums;
         }
         void qpl::filesys::combine_files(const qpl::filesys::paths& paths, const qpl::filesys::path& destination) {
-            std::ofstream file(destination.c_str(), std::ios::binary);
-            if (!file.good()) {
-                qpl::println("there was a problem creating \"", destination.string(), "\"");
+            qpl::filesys::combine_files(paths, destination, qpl::filesys::split_options{});
+        }
+        std::vector<qpl::u64> qpl::filesys::combine_files(const qpl::filesys::paths& paths, const qpl::filesys::path& destination, const qpl::filesys::split_options& options) {
+            std::vector<qpl::u64> offsets(paths.size() + 1);
+            for (qpl::size i = 0u; i < paths.size(); ++i) {
+                offsets[i + 1] = offsets[i] + static_cast<qpl::u64>(std::filesystem::file_size(paths[i].string()));
+            }
+
+            {
+                std::ofstream file(destination.c_str(), std::ios::binary);
+                if (!file.good()) {
+                    throw std::runtime_error(qpl::to_string("there was a problem creating \"", destination.string(), "\"").c_str());
+                }
+            }
+            std::filesystem::resize_file(destination.string(), offsets.back());
+
+            std::vector<qpl::u64> checksums(options.checksums ? paths.size() : 0u);
+
+            //the destination has its final size, so every part is written at its own offset through its own stream
+            detail::parallel_jobs(paths.size(), options.threads, [&](qpl::size i, std::vector<char>& buffer) {
+                buffer.resize(options.buffer_size);
+
+                std::ifstream part(paths[i].string(), std::ios::binary);
+                std::ofstream file(destination.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+                if (!part.good()) {
+                    throw std::runtime_error(qpl::to_string("failed to open file \"", paths[i], "\"").c_str());
+                }
+                if (!file.good()) {
+                    throw std::runtime_error(qpl::to_string("failed to open file \"", destination, "\"").c_str());
+                }
+                file.seekp(static_cast<std::streamoff>(offsets[i]));
+
+                detail::xxhash64 hash;
+                detail::copy_stream(part, file, offsets[i + 1] - offsets[i], buffer, options.checksums ? &hash : nullptr);
+                file.close();
+                if (file.fail()) {
+                    throw std::runtime_error(qpl::to_string("there was a problem writing \"", destination, "\"").c_str());
+                }
+                if (options.checksums) {
+                    checksums[i] = hash.digest();
+                }
+            });
+            return checksums;
+        }
+
+        namespace detail {
+            bool snapshot_stat(const std::string& path, qpl::filesys::snapshot_entry& entry) {
+                entry.path = path;
+#ifdef _WIN32
+                WIN32_FILE_ATTRIBUTE_DATA data;
+                if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) {
+                    return false;
+                }
+                entry.directory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+                entry.size = entry.directory ? 0u : (qpl::u64{ data.nFileSizeHigh } << 32) | data.nFileSizeLow;
+                entry.time = static_cast<qpl::i64>((qpl::u64{ data.ftLastWriteTime.dwHighDateTime } << 32) | data.ftLastWriteTime.dwLowDateTime);
+                entry.id = 0u;
+#else
+                struct stat info;
+                if (::stat(path.c_str(), &info) != 0) {
+                    return false;
+                }
+                entry.directory = S_ISDIR(info.st_mode);
+                entry.size = entry.directory ? 0u : static_cast<qpl::u64>(info.st_size);
+#ifdef __APPLE__
+                entry.time = static_cast<qpl::i64>(info.st_mtimespec.tv_sec) * 1'000'000'000 + info.st_mtimespec.tv_nsec;
+#else
+                entry.time = static_cast<qpl::i64>(info.st_mtim.tv_sec) * 1'000'000'000 + info.st_mtim.tv_nsec;
+#endif
+                entry.id = static_cast<qpl::u64>(info.st_ino);
+#endif
+                return true;
+            }
+            bool snapshot_entry_less(const qpl::filesys::snapshot_entry& a, const qpl::filesys::snapshot_entry& b) {
+                return a.path < b.path;
+            }
+
+            void write_varint(std::string& data, qpl::u64 value) {
+                while (value >= 0x80u) {
+                    data.push_back(static_cast<char>((value & 0x7fu) | 0x80u));
+                    value >>= 7;
+                }
+                data.push_back(static_cast<char>(value));
+            }
+            qpl::u64 read_varint(qpl::string_view& data) {
+                qpl::u64 value = 0u;
+                for (qpl::u32 shift = 0u; shift < 64u; shift += 7u) {
+                    if (data.empty()) {
+                        break;
+                    }
+                    auto byte = static_cast<qpl::u8>(data.front());
+                    data.remove_prefix(1);
+                    value |= qpl::u64{ byte & 0x7fu } << shift;
+                    if (!(byte & 0x80u)) {
+                        return value;
+                    }
+                }
+                throw std::runtime_error("qpl::filesys::snapshot::load: corrupted file");
+            }
+            qpl::string_view read_bytes(qpl::string_view& data, qpl::u64 size) {
+                if (size > data.size()) {
+                    throw std::runtime_error("qpl::filesys::snapshot::load: corrupted file");
+                }
+                auto result = data.substr(0u, static_cast<qpl::size>(size));
+                data.remove_prefix(static_cast<qpl::size>(size));
+                return result;
+            }
+
+            constexpr qpl::string_view snapshot_magic = "QPLSNAP1";
+
+            //directories can vanish again before the watcher gets to them, their removal is reported as its own event
+            qpl::filesys::walk_options watcher_walk_options() {
+                qpl::filesys::walk_options options;
+                options.on_error = [](const qpl::filesys::path&, const std::error_code&) {};
+                return options;
+            }
+        }
+
+        bool qpl::filesys::snapshot_diff::empty() const {
+            return this->added.empty() && this->removed.empty() && this->modified.empty();
+        }
+
+        qpl::filesys::snapshot qpl::filesys::snapshot::scan(const qpl::filesys::path& root, const qpl::filesys::walk_options& options) {
+            qpl::filesys::snapshot result;
+            result.m_root = root.string();
+            while (result.m_root.size() > 1u && result.m_root.back() == '/') {
+                result.m_root.pop_back();
+            }
+
+            walk_options unordered = options;
+            unordered.ordered = false;
+            auto list = qpl::filesys::walk(root, {}, unordered);
+
+            //stat in blocks on the same threads, entries that vanished since the walk are dropped
+            constexpr qpl::size block_size = 4096u;
+            std::vector<qpl::filesys::snapshot_entry> entries(list.size());
+            std::vector<char> found(list.size());
+            detail::parallel_jobs((list.size() + block_size - 1) / block_size, options.threads, [&](qpl::size block, std::vector<char>&) {
+                auto end = qpl::min((block + 1) * block_size, list.size());
+                for (qpl::size i = block * block_size; i < end; ++i) {
+                    found[i] = detail::snapshot_stat(list[i].string(), entries[i]);
+                }
+            });
+
+            result.m_entries.reserve(entries.size());
+            for (qpl::size i = 0u; i < entries.size(); ++i) {
+                if (found[i]) {
+                    result.m_entries.emplace_back(std::move(entries[i]));
+                }
+            }
+            std::sort(result.m_entries.begin(), result.m_entries.end(), detail::snapshot_entry_less);
+            return result;
+        }
+
+        //format: magic, root, count, then per entry (sorted) the length of the prefix shared with the previous path,
+        //the rest of the path, flags, size, time and id. numbers are varints, the time zigzag encoded
+        qpl::filesys::snapshot qpl::filesys::snapshot::load(const qpl::filesys::path& file) {
+            //read instead of mapped: a save replacing the file meanwhile can't truncate it under the reader
+            auto content = detail::read_whole_file(file.string());
+            std::string_view data = content;
+            if (data.substr(0u, detail::snapshot_magic.size()) != detail::snapshot_magic) {
+                throw std::runtime_error(qpl::to_string("qpl::filesys::snapshot::load: \"", file, "\" is not a snapshot").c_str());
+            }
+            data.remove_prefix(detail::snapshot_magic.size());
+
+            qpl::filesys::snapshot result;
+            result.m_root = std::string(detail::read_bytes(data, detail::read_varint(data)));
+            auto count = detail::read_varint(data);
+            //every entry takes at least 5 bytes, anything claiming more is corrupted
+            if (count > data.size() / 5u) {
+                throw std::runtime_error("qpl::filesys::snapshot::load: corrupted file");
+            }
+            result.m_entries.resize(static_cast<qpl::size>(count));
+
+            const std::string* previous = nullptr;
+            for (auto& entry : result.m_entries) {
+                auto shared = detail::read_varint(data);
+                if (shared > (previous ? previous->size() : 0u)) {
+                    throw std::runtime_error("qpl::filesys::snapshot::load: corrupted file");
+                }
+                auto rest = detail::read_bytes(data, detail::read_varint(data));
+                if (previous) {
+                    entry.path.assign(*previous, 0u, static_cast<qpl::size>(shared));
+                }
+                entry.path.append(rest);
+
+                auto flags = detail::read_bytes(data, 1u);
+                entry.directory = flags.front() & 1;
+                entry.size = detail::read_varint(data);
+                auto time = detail::read_varint(data);
+                entry.time = static_cast<qpl::i64>(time >> 1) ^ -static_cast<qpl::i64>(time & 1u);
+                entry.id = detail::read_varint(data);
+                previous = &entry.path;
+            }
+            return result;
+        }
+        void qpl::filesys::snapshot::save(const qpl::filesys::path& file) const {
+            std::string data;
+            data.append(detail::snapshot_magic);
+            detail::write_varint(data, this->m_root.size());
+            data.append(this->m_root);
+            detail::write_varint(data, this->m_entries.size());
+
+            const std::string* previous = nullptr;
+            for (auto& entry : this->m_entries) {
+                qpl::size shared = 0u;
+                if (previous) {
+                    auto stop = qpl::min(previous->size(), entry.path.size());
+                    while (shared < stop && (*previous)[shared] == entry.path[shared]) {
+                        ++shared;
+                    }
+                }
+                detail::write_varint(data, shared);
+                detail::write_varint(data, entry.path.size() - shared);
+                data.append(entry.path, shared);
+                data.push_back(static_cast<char>(entry.directory));
+                detail::write_varint(data, entry.size);
+                detail::write_varint(data, (static_cast<qpl::u64>(entry.time) << 1) ^ static_cast<qpl::u64>(entry.time >> 63));
+                detail::write_varint(data, entry.id);
+                previous = &entry.path;
+            }
+
+            //written next to the target and renamed over it, so a reader sees either the old or the new snapshot
+            auto temporary = qpl::to_string(file.string(), ".", std::hash<std::thread::id>{}(std::this_thread::get_id()), ".tmp");
+            std::ofstream stream(temporary, std::ios::binary);
+            if (!stream.good()) {
+                throw std::runtime_error(qpl::to_string("qpl::filesys::snapshot::save: failed to create \"", temporary, "\"").c_str());
+            }
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+
+            std::error_code error;
+            if (stream.fail()) {
+                std::filesystem::remove(temporary, error);
+                throw std::runtime_error(qpl::to_string("qpl::filesys::snapshot::save: failed to write \"", temporary, "\"").c_str());
+            }
+            std::filesystem::rename(temporary, file.string(), error);
+            if (error) {
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                throw std::filesystem::filesystem_error("qpl::filesys::snapshot::save", temporary, file.string(), error);
+            }
+        }
+
+        void qpl::filesys::snapshot::update(const std::vector<std::string>& paths) {
+            std::vector<qpl::filesys::snapshot_entry> changed;
+            std::vector<std::string> gone;
+            for (auto& path : paths) {
+                qpl::filesys::snapshot_entry entry;
+                if (detail::snapshot_stat(path, entry)) {
+                    changed.emplace_back(std::move(entry));
+                }
+                else {
+                    gone.push_back(path);
+                }
+            }
+            std::sort(changed.begin(), changed.end(), detail::snapshot_entry_less);
+            std::sort(gone.begin(), gone.end());
+
+            auto is_gone = [&](const std::string& path) {
+                //the path itself or any of its parent directories
+                for (auto i = path.size(); i != std::string::npos && i; i = path.rfind('/', i - 1)) {
+                    if (std::binary_search(gone.begin(), gone.end(), path.substr(0u, i))) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            std::vector<qpl::filesys::snapshot_entry> result;
+            result.reserve(this->m_entries.size() + changed.size());
+            auto it = changed.begin();
+            for (auto& entry : this->m_entries) {
+                while (it != changed.end() && it->path < entry.path) {
+                    result.emplace_back(std::move(*it++));
+                }
+                if (it != changed.end() && it->path == entry.path) {
+                    result.emplace_back(std::move(*it++));
+                }
+                else if (gone.empty() || !is_gone(entry.path)) {
+                    result.emplace_back(std::move(entry));
+                }
+            }
+            std::move(it, changed.end(), std::back_inserter(result));
+            this->m_entries = std::move(result);
+        }
+
+        const qpl::filesys::snapshot_entry* qpl::filesys::snapshot::find(const qpl::string_view& path) const {
+            auto it = std::lower_bound(this->m_entries.begin(), this->m_entries.end(), path, [](const qpl::filesys::snapshot_entry& entry, const qpl::string_view& path) {
+                return qpl::string_view(entry.path) < path;
+            });
+            if (it != this->m_entries.end() && it->path == path) {
+                return &*it;
             }
-            for (auto& i : paths) {
-               file << i.read();
+            return nullptr;
+        }
+        const std::vector<qpl::filesys::snapshot_entry>& qpl::filesys::snapshot::entries() const {
+            return this->m_entries;
+        }
+        const std::string& qpl::filesys::snapshot::root() const {
+            return this->m_root;
+        }
+        qpl::size qpl::filesys::snapshot::size() const {
+            return this->m_entries.size();
+        }
+        bool qpl::filesys::snapshot::empty() const {
+            return this->m_entries.empty();
+        }
+
+        qpl::filesys::snapshot_diff qpl::filesys::diff(const qpl::filesys::snapshot& before, const qpl::filesys::snapshot& after) {
+            qpl::filesys::snapshot_diff result;
+            auto& a = before.entries();
+            auto& b = after.entries();
+
+            //both are sorted by path, so a single merge pass finds everything
+            qpl::size i = 0u;
+            qpl::size j = 0u;
+            while (i < a.size() && j < b.size()) {
+                if (a[i].path < b[j].path) {
+                    result.removed.push_back(a[i++].path);
+                }
+                else if (b[j].path < a[i].path) {
+                    result.added.push_back(b[j++].path);
+                }
+                else {
+                    bool modified = a[i].directory != b[j].directory || a[i].id != b[j].id;
+                    if (!a[i].directory) {
+                        modified = modified || a[i].size != b[j].size || a[i].time != b[j].time;
+                    }
+                    if (modified) {
+                        result.modified.push_back(b[j].path);
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            for (; i < a.size(); ++i) {
+                result.removed.push_back(a[i].path);
+            }
+            for (; j < b.size(); ++j) {
+                result.added.push_back(b[j].path);
+            }
+            return result;
+        }
+
+#if defined(_WIN32)
+        struct qpl::filesys::snapshot_watcher::state {
+            std::string root;
+            HANDLE directory = INVALID_HANDLE_VALUE;
+            OVERLAPPED overlapped{};
+            alignas(DWORD) char buffer[1 << 16];
+
+            //whether the kernel may still write into buffer / overlapped
+            bool pending = false;
+
+            bool listen() {
+                constexpr DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+                this->overlapped = OVERLAPPED{};
+                this->pending = ReadDirectoryChangesW(this->directory, this->buffer, sizeof(this->buffer), TRUE, filter, nullptr, &this->overlapped, nullptr);
+                return this->pending;
+            }
+        };
+#elif defined(__linux__)
+        struct qpl::filesys::snapshot_watcher::state {
+            std::string root;
+            int descriptor = -1;
+            std::unordered_map<int, std::string> watches;
+
+            //some directory has no watch (e.g. ENOSPC at max_user_watches), so events can't be trusted and poll rescans
+            bool incomplete = false;
+
+            void watch(const std::string& directory) {
+                constexpr qpl::u32 mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+                auto id = inotify_add_watch(this->descriptor, directory.c_str(), mask);
+                if (id != -1) {
+                    this->watches[id] = directory;
+                }
+                else if (errno != ENOENT) {
+                    this->incomplete = true;
+                }
+            }
+            void watch_tree(const std::string& directory, std::vector<std::string>* contents) {
+                this->watch(directory);
+                for (auto& path : qpl::filesys::walk(directory, {}, detail::watcher_walk_options())) {
+                    if (path.is_directory()) {
+                        this->watch(path.string());
+                    }
+                    if (contents) {
+                        contents->push_back(path.string());
+                    }
+                }
+            }
+            void unwatch_tree(const std::string& directory) {
+                for (auto it = this->watches.begin(); it != this->watches.end();) {
+                    auto& path = it->second;
+                    if (path == directory || (path.size() > directory.size() && path.compare(0u, directory.size(), directory) == 0 && path[directory.size()] == '/')) {
+                        inotify_rm_watch(this->descriptor, it->first);
+                        it = this->watches.erase(it);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+            }
+        };
+#else
+        struct qpl::filesys::snapshot_watcher::state {
+            std::string root;
+        };
+#endif
+
+        qpl::filesys::snapshot_watcher::snapshot_watcher(const qpl::filesys::snapshot& snapshot) : m_state(std::make_unique<state>()) {
+            this->m_state->root = snapshot.root();
+#if defined(_WIN32)
+            this->m_state->directory = CreateFileA(snapshot.root().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (this->m_state->directory == INVALID_HANDLE_VALUE || !this->m_state->listen()) {
+                throw std::runtime_error(qpl::to_string("qpl::filesys::snapshot_watcher: can't watch \"", snapshot.root(), "\"").c_str());
+            }
+#elif defined(__linux__)
+            this->m_state->descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (this->m_state->descriptor == -1) {
+                throw std::runtime_error(qpl::to_string("qpl::filesys::snapshot_watcher: can't watch \"", snapshot.root(), "\"").c_str());
+            }
+            this->m_state->watch_tree(snapshot.root(), nullptr);
+#endif
+        }
+        qpl::filesys::snapshot_watcher::~snapshot_watcher() {
+#if defined(_WIN32)
+            auto& state = *this->m_state;
+            if (state.directory != INVALID_HANDLE_VALUE) {
+                //the pending read has to finish before buffer and overlapped are freed
+                if (state.pending) {
+                    DWORD bytes = 0;
+                    CancelIoEx(state.directory, &state.overlapped);
+                    GetOverlappedResult(state.directory, &state.overlapped, &bytes, TRUE);
+                }
+                CloseHandle(state.directory);
+            }
+#elif defined(__linux__)
+            if (this->m_state->descriptor != -1) {
+                ::close(this->m_state->descriptor);
+            }
+#endif
+        }
+
+        std::vector<std::string> qpl::filesys::snapshot_watcher::poll(qpl::filesys::snapshot& snapshot) {
+            std::vector<std::string> changed;
+            bool overflow = false;
+
+#if defined(_WIN32)
+            auto& state = *this->m_state;
+            DWORD bytes = 0;
+            while (state.pending) {
+                if (!GetOverlappedResult(state.directory, &state.overlapped, &bytes, FALSE)) {
+                    if (GetLastError() == ERROR_IO_INCOMPLETE) {
+                        break;
+                    }
+                    //e.g. ERROR_NOTIFY_ENUM_DIR, the changes didn't fit into the buffer
+                    bytes = 0;
+                }
+                state.pending = false;
+                if (!bytes) {
+                    overflow = true;
+                }
+                for (qpl::size offset = 0u; bytes;) {
+                    auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(state.buffer + offset);
+                    auto length = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+                    std::string name(WideCharToMultiByte(CP_ACP, 0, info->FileName, length, nullptr, 0, nullptr, nullptr), '\0');
+                    WideCharToMultiByte(CP_ACP, 0, info->FileName, length, name.data(), static_cast<int>(name.size()), nullptr, nullptr);
+                    std::replace(name.begin(), name.end(), '\\', '/');
+                    auto path = state.root + "/" + name;
+
+                    if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+                        std::error_code error;
+                        if (std::filesystem::is_directory(path, error)) {
+                            for (auto& entry : qpl::filesys::walk(path, {}, detail::watcher_walk_options())) {
+                                changed.push_back(entry.string());
+                            }
+                        }
+                    }
+                    changed.push_back(std::move(path));
+
+                    if (!info->NextEntryOffset) {
+                        break;
+                    }
+                    offset += info->NextEntryOffset;
+                }
+                if (!state.listen()) {
+                    overflow = true;
+                    break;
+                }
             }
-            file.flush();
+#elif defined(__linux__)
+            auto& state = *this->m_state;
+            alignas(inotify_event) char buffer[1 << 16];
+            while (true) {
+                auto size = ::read(state.descriptor, buffer, sizeof(buffer));
+                if (size <= 0) {
+                    break;
+                }
+                for (qpl::isize offset = 0; offset < size;) {
+                    auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        overflow = true;
+                        continue;
+                    }
+                    auto it = state.watches.find(event->wd);
+                    if (it == state.watches.end() || !event->len) {
+                        continue;
+                    }
+                    auto path = it->second + "/" + event->name;
+                    if (event->mask & IN_ISDIR) {
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                            state.watch_tree(path, &changed);
+                        }
+                        else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                            state.unwatch_tree(path);
+                        }
+                    }
+                    changed.push_back(std::move(path));
+                }
+            }
+            overflow = overflow || state.incomplete;
+#else
+            overflow = true;
+#endif
+
+            if (overflow) {
+#if defined(_WIN32)
+                if (!state.pending) {
+                    state.listen();
+                }
+#elif defined(__linux__)
+                //directories created while events were lost have no watch yet, existing ones keep theirs
+                state.incomplete = false;
+                state.watch_tree(state.root, nullptr);
+#endif
+                //events were lost, compare against a fresh scan instead
+                auto rescan = qpl::filesys::snapshot::scan(this->m_state->root, detail::watcher_walk_options());
+                auto difference = qpl::filesys::diff(snapshot, rescan);
+                snapshot = std::move(rescan);
+                changed = std::move(difference.added);
+                changed.insert(changed.end(), difference.removed.begin(), difference.removed.end());
+                changed.insert(changed.end(), difference.modified.begin(), difference.modified.end());
+                return changed;
+            }
+
+            std::sort(changed.begin(), changed.end());
+            changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+            snapshot.update(changed);
+            return changed;
         }
 
         qpl::filesys::paths qpl::filesys::list_directory(const qpl::filesys::path& path) {
@@ -2661,74 +4210,218 @@ namespace qpl {
         }
 
         void qpl::filesys::move_all(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                i.move(path_destination);
-            }
+            qpl::filesys::paths(files).move_to(path_destination);
         }
         void qpl::filesys::copy_all(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                i.copy(path_destination);
-            }
+            qpl::filesys::paths(files).copy_to(path_destination);
         }
         void qpl::filesys::move_all_overwrite(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                i.move_overwrite(path_destination);
-            }
+            qpl::filesys::paths(files).move_overwrite_to(path_destination);
         }
         void qpl::filesys::copy_all_overwrite(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                qpl::println(i);
-            }
+            qpl::filesys::paths(files).copy_overwrite_to(path_destination);
         }
 
         void qpl::filesys::move_all_files(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                if (i.is_file()) {
-                    i.move(path_destination);
-                }
-            }
+            qpl::filesys::paths(files).move_files_to(path_destination);
         }
         void qpl::filesys::copy_all_files(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                if (i.is_file()) {
-                    i.copy(path_destination);
-                }
-            }
+            qpl::filesys::paths(files).copy_files_to(path_destination);
         }
         void qpl::filesys::move_all_files_overwrite(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                if (i.is_file()) {
-                    i.move_overwrite(path_destination);
-                }
-            }
+            qpl::filesys::paths(files).move_overwrite_files_to(path_destination);
         }
         void qpl::filesys::copy_all_files_overwrite(const qpl::filesys::paths& files, const qpl::filesys::path& path_destination) {
-            for (auto& i : files) {
-                if (i.is_file()) {
-                    i.copy_overwrite(path_destination);
+            qpl::filesys::paths(files).copy_overwrite_files_to(path_destination);
+        }
+
+        namespace detail {
+#ifndef _WIN32
+            struct descriptor_guard {
+                int descriptor;
+                ~descriptor_guard() {
+                    if (this->descriptor != -1) {
+                        ::close(this->descriptor);
+                    }
+                }
+            };
+#endif
+#ifndef _WIN32
+            //returns 0 or the errno that stopped the copy
+            int copy_descriptor(int in, int out, std::vector<char>& buffer, qpl::size buffer_size) {
+#ifdef __linux__
+                //reflink shares the extents on copy on write filesystems
+                if (::ioctl(out, FICLONE, in) == 0) {
+                    return 0;
+                }
+                //in kernel copy, falls back to streaming from the current offsets if the filesystems don't support it
+                while (true) {
+                    auto copied = ::copy_file_range(in, nullptr, out, nullptr, qpl::size{ 1 } << 30, 0u);
+                    if (copied == 0) {
+                        return 0;
+                    }
+                    if (copied < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        if (errno != EXDEV && errno != ENOSYS && errno != EINVAL && errno != EOPNOTSUPP && errno != EPERM) {
+                            return errno;
+                        }
+                        break;
+                    }
+                }
+#endif
+                buffer.resize(buffer_size);
+                while (true) {
+                    auto read = ::read(in, buffer.data(), buffer.size());
+                    if (read == 0) {
+                        return 0;
+                    }
+                    if (read < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return errno;
+                    }
+                    for (qpl::isize written = 0; written < read;) {
+                        auto result = ::write(out, buffer.data() + written, static_cast<qpl::size>(read - written));
+                        if (result < 0) {
+                            if (errno == EINTR) {
+                                continue;
+                            }
+                            return errno;
+                        }
+                        written += result;
+                    }
                 }
             }
-        }
+#endif
+            void transfer_file(const std::string& source, const std::string& destination, bool overwrite, std::vector<char>& buffer, qpl::size buffer_size) {
+#ifdef _WIN32
+                //copying a file onto itself would truncate it
+                std::error_code equivalent_error;
+                if (std::filesystem::equivalent(source, destination, equivalent_error)) {
+                    throw std::filesystem::filesystem_error("qpl::filesys::transfer_files", source, destination, std::make_error_code(std::errc::file_exists));
+                }
+                //CopyFile2 underneath, which offloads or block clones where the volume supports it
+                auto copy_options = overwrite ? std::filesystem::copy_options::overwrite_existing : std::filesystem::copy_options::none;
+                std::filesystem::copy_file(source, destination, copy_options);
+#else
+                auto fail = [&](int error) {
+                    throw std::filesystem::filesystem_error("qpl::filesys::transfer_files", source, destination, std::error_code(error, std::generic_category()));
+                };
+
+                descriptor_guard in{ ::open(source.c_str(), O_RDONLY) };
+                if (in.descriptor == -1) {
+                    fail(errno);
+                }
+                struct stat info;
+                if (::fstat(in.descriptor, &info) == -1) {
+                    fail(errno);
+                }
+                struct stat existing;
+                if (::stat(destination.c_str(), &existing) == 0) {
+                    //same check as std::filesystem::copy_file, copying a file onto itself would truncate it
+                    if (!overwrite || (existing.st_dev == info.st_dev && existing.st_ino == info.st_ino)) {
+                        fail(EEXIST);
+                    }
+                }
 
+                //overwrites are written to a temporary file next to the destination that replaces it at the end,
+                //so a failed copy leaves the old file as it was
+                std::string target = overwrite ? destination + ".qpl-XXXXXX" : destination;
+                descriptor_guard out{ overwrite ? ::mkstemp(target.data()) : ::open(target.c_str(), O_WRONLY | O_CREAT | O_EXCL, info.st_mode & 0777) };
+                if (out.descriptor == -1) {
+                    fail(errno);
+                }
 
+                struct partial_guard {
+                    const std::string& path;
+                    bool done = false;
+                    ~partial_guard() {
+                        if (!this->done) {
+                            ::unlink(this->path.c_str());
+                        }
+                    }
+                } partial{ target };
 
-        std::string qpl::filesys::read_file(const std::string& path) {
-            std::ifstream file(path, std::ios::ate | std::ios::binary);
+                if (overwrite && ::fchmod(out.descriptor, info.st_mode & 0777) == -1) {
+                    fail(errno);
+                }
+                if (auto error = copy_descriptor(in.descriptor, out.descriptor, buffer, buffer_size)) {
+                    fail(error);
+                }
+                if (overwrite && ::rename(target.c_str(), destination.c_str()) == -1) {
+                    fail(errno);
+                }
+                partial.done = true;
+#endif
+            }
+        }
 
-            if (!file.is_open()) {
-                throw std::runtime_error(qpl::to_string("failed to open file \"", path, "\"").c_str());
+        qpl::f64 qpl::filesys::transfer_progress::bytes_per_second() const {
+            return this->seconds > 0.0 ? this->bytes_done / this->seconds : 0.0;
+        }
+
+        qpl::filesys::transfer_progress qpl::filesys::transfer_files(const std::vector<qpl::filesys::transfer_job>& jobs, const qpl::filesys::transfer_options& options) {
+            qpl::filesys::transfer_progress progress;
+            progress.files_total = jobs.size();
+            if (jobs.empty()) {
+                return progress;
             }
 
-            auto file_size = (size_t)file.tellg();
-            std::string buffer;
-            buffer.resize(file_size);
+            //largest files first, so a big file doesn't end up alone at the tail
+            std::vector<qpl::u64> sizes(jobs.size());
+            std::vector<qpl::size> order(jobs.size());
+            for (qpl::size i = 0u; i < jobs.size(); ++i) {
+                std::error_code error;
+                auto size = std::filesystem::file_size(jobs[i].source.string(), error);
+                sizes[i] = error ? 0u : static_cast<qpl::u64>(size);
+                progress.bytes_total += sizes[i];
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&](qpl::size a, qpl::size b) {
+                return sizes[a] > sizes[b];
+            });
+
+            auto start = std::chrono::steady_clock::now();
+            auto elapsed = [&]() {
+                return std::chrono::duration<qpl::f64>(std::chrono::steady_clock::now() - start).count();
+            };
 
-            file.seekg(0);
-            file.read(buffer.data(), file_size);
+            std::atomic<qpl::size> files_done = 0u;
+            std::atomic<qpl::u64> bytes_done = 0u;
+            std::mutex progress_mutex;
+
+            detail::parallel_jobs(jobs.size(), options.queue_depth, [&](qpl::size index, std::vector<char>& buffer) {
+                auto& job = jobs[order[index]];
+                detail::transfer_file(job.source.string(), job.destination.string(), options.overwrite, buffer, options.buffer_size);
+                if (options.move) {
+                    std::filesystem::remove(job.source.string());
+                }
+                files_done.fetch_add(1u, std::memory_order_relaxed);
+                bytes_done.fetch_add(sizes[order[index]], std::memory_order_relaxed);
+
+                if (options.progress) {
+                    std::lock_guard lock(progress_mutex);
+                    auto snapshot = progress;
+                    snapshot.files_done = files_done.load(std::memory_order_relaxed);
+                    snapshot.bytes_done = bytes_done.load(std::memory_order_relaxed);
+                    snapshot.seconds = elapsed();
+                    options.progress(snapshot);
+                }
+            });
+
+            progress.files_done = files_done;
+            progress.bytes_done = bytes_done;
+            progress.seconds = elapsed();
+            return progress;
+        }
 
-            file.close();
 
-            return buffer;
+
+        std::string qpl::filesys::read_file(const std::string& path) {
+            return detail::read_whole_file(path);
         }
         std::filesystem::file_time_type qpl::filesys::file_last_write_time(const std::string& path) {
             qpl::filesys::path p = path;
@@ -7,8 +7,12 @@ namespace qpl {
 	std::vector<std::vector<qpl::u32>> sudoku_sum_possibilities(qpl::size sum, qpl::size numbers) {
 		std::vector<std::vector<qpl::u32>> result;
 
-		auto arrangements = qpl::list_all_arrangements(qpl::vector_0_to_n(9u, 1u), numbers);
+		auto digits = qpl::vector_0_to_n(9u, 1u);
 
+		//digits are increasing, so a prefix that already exceeds sum can't be completed
+		auto arrangements = qpl::arrangements_range(digits, numbers, [&](qpl::span<const qpl::u32> prefix) {
+			return std::accumulate(prefix.begin(), prefix.end(), qpl::size{ 0u }) <= sum;
+		});
 		for (auto& i : arrangements) {
 			if (qpl::container_sum(i) == sum) {
 				result.push_back(i);
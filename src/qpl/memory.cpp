@@ -1,6 +1,17 @@
 #include <qpl/memory.hpp>
 #include <qpl/string.hpp>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace qpl {
 
 	void qpl::print_character_bool_table(qpl::string_view characters) {
@@ -22,4 +33,171 @@ namespace qpl {
 		}
 		qpl::println('}');
 	}
+
+	namespace detail {
+		bool register_heavy_barrier() {
+#if defined(_WIN32)
+			return true;
+#elif defined(__linux__) && defined(SYS_membarrier)
+			auto commands = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0);
+			if (commands < 0 || !(commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED)) {
+				return false;
+			}
+			return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+			return false;
+#endif
+		}
+	}
+	const bool qpl::detail::heavy_barrier_supported = qpl::detail::register_heavy_barrier();
+
+	void qpl::detail::heavy_barrier() {
+		if (!qpl::detail::heavy_barrier_supported) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			return;
+		}
+#if defined(_WIN32)
+		FlushProcessWriteBuffers();
+#elif defined(__linux__) && defined(SYS_membarrier)
+		syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+#endif
+	}
+
+	qpl::arena::arena(qpl::size block_size) : m_block_size(block_size) {
+
+	}
+	qpl::arena::~arena() {
+		this->release();
+	}
+	void* qpl::arena::allocate(qpl::size bytes, qpl::size alignment) {
+		++this->m_allocations;
+		while (true) {
+			while (this->m_block_index < this->m_blocks.size()) {
+				auto& block = this->m_blocks[this->m_block_index];
+				auto address = reinterpret_cast<std::uintptr_t>(block.memory) + this->m_offset;
+				auto aligned = (address + (alignment - 1)) & ~std::uintptr_t{ alignment - 1 };
+				auto offset = this->m_offset + (aligned - address);
+				if (offset + bytes <= block.size) {
+					this->m_offset = offset + bytes;
+					return block.memory + offset;
+				}
+				++this->m_block_index;
+				this->m_offset = 0u;
+			}
+			arena::block block;
+			block.size = qpl::max(this->m_block_size, bytes + alignment);
+			block.memory = static_cast<std::byte*>(::operator new(block.size));
+			this->m_blocks.push_back(block);
+		}
+	}
+	void qpl::arena::deallocate(void* ptr, qpl::size bytes) {
+		if (this->m_block_index < this->m_blocks.size()) {
+			auto& block = this->m_blocks[this->m_block_index];
+			if (static_cast<std::byte*>(ptr) + bytes == block.memory + this->m_offset) {
+				this->m_offset -= bytes;
+			}
+		}
+	}
+	void qpl::arena::reset() {
+		this->m_block_index = 0u;
+		this->m_offset = 0u;
+		this->m_allocations = 0u;
+	}
+	void qpl::arena::release() {
+		for (auto& block : this->m_blocks) {
+			::operator delete(block.memory);
+		}
+		this->m_blocks.clear();
+		this->reset();
+	}
+	qpl::arena::marker qpl::arena::mark() const {
+		return qpl::arena::marker{ this->m_block_index, this->m_offset };
+	}
+	void qpl::arena::rewind(qpl::arena::marker marker) {
+		this->m_block_index = marker.block;
+		this->m_offset = marker.offset;
+	}
+	qpl::size qpl::arena::used() const {
+		qpl::size result = this->m_offset;
+		for (qpl::size i = 0u; i < qpl::min(this->m_block_index, this->m_blocks.size()); ++i) {
+			result += this->m_blocks[i].size;
+		}
+		return result;
+	}
+	qpl::size qpl::arena::capacity() const {
+		qpl::size result = 0u;
+		for (auto& block : this->m_blocks) {
+			result += block.size;
+		}
+		return result;
+	}
+	qpl::size qpl::arena::allocations() const {
+		return this->m_allocations;
+	}
+
+	qpl::detail::pool_resource::~pool_resource() {
+		for (auto& chunk : this->m_chunks) {
+			::operator delete(chunk, std::align_val_t{ granularity });
+		}
+	}
+	void* qpl::detail::pool_resource::allocate(qpl::size bytes, qpl::size alignment) {
+		if (!bytes || bytes > granularity * size_classes || alignment > granularity) {
+			return ::operator new(bytes, std::align_val_t{ alignment });
+		}
+		auto size_class = (bytes - 1) / granularity;
+		if (!this->m_free[size_class]) {
+			this->grow(size_class);
+		}
+		auto result = this->m_free[size_class];
+		this->m_free[size_class] = result->next;
+		return result;
+	}
+	void qpl::detail::pool_resource::deallocate(void* ptr, qpl::size bytes, qpl::size alignment) {
+		if (!bytes || bytes > granularity * size_classes || alignment > granularity) {
+			::operator delete(ptr, std::align_val_t{ alignment });
+			return;
+		}
+		auto size_class = (bytes - 1) / granularity;
+		auto node = static_cast<pool_resource::node*>(ptr);
+		node->next = this->m_free[size_class];
+		this->m_free[size_class] = node;
+	}
+	void qpl::detail::pool_resource::grow(qpl::size size_class) {
+		auto slot_size = (size_class + 1) * granularity;
+		auto chunk = static_cast<std::byte*>(::operator new(chunk_bytes, std::align_val_t{ granularity }));
+		this->m_chunks.push_back(chunk);
+		for (qpl::size i = chunk_bytes / slot_size; i-- > 0u;) {
+			auto node = reinterpret_cast<pool_resource::node*>(chunk + i * slot_size);
+			node->next = this->m_free[size_class];
+			this->m_free[size_class] = node;
+		}
+	}
+
+	void qpl::detail::array_index_error(std::string(*type_name)(), qpl::size N, qpl::size index, bool at) {
+		std::ostringstream stream;
+		stream << qpl::to_string("qpl::array<", type_name(), ", ", N, ">", at ? ".at()" : "::operator[]", " : index is ", index);
+		qpl::i32 convert = qpl::i32_cast(index);
+		if (convert < 0) {
+			stream << qpl::to_string(" (= ", convert, ") ");
+		}
+		qpl::println(stream.str());
+		throw std::exception(stream.str().c_str());
+	}
+	void qpl::detail::vector_index_error(std::string(*type_name)(), qpl::size size, qpl::size index, bool at) {
+		std::ostringstream stream;
+		stream << qpl::to_string("qpl::vector<", type_name(), ">", at ? ".at()" : "::operator[]", " : index is ", index);
+		qpl::i32 convert = qpl::i32_cast(index);
+		if (convert < 0) {
+			stream << qpl::to_string(" (= ", convert, ") ");
+		}
+		stream << " - size of vector is " << size;
+		qpl::println(stream.str());
+		throw std::exception(stream.str().c_str());
+	}
+	void qpl::detail::vector_empty_error(std::string(*type_name)(), bool front) {
+		std::ostringstream stream;
+		stream << qpl::to_string("qpl::vector<", type_name(), ">", front ? ".front()" : ".back()", " : vector is empty");
+		qpl::println(stream.str());
+		throw std::exception(stream.str().c_str());
+	}
 }
\ No newline at end of file
@@ -575,7 +575,7 @@ namespace qpl {
 		return 1.0 / (1.0 + std::exp(-n));
 	}
 	qpl::f64 qpl::NN2::normal_distribution() {
-		return std::sin(2.0 * qpl::pi * qpl::random(std::numeric_limits<double>::epsilon(), 1.0)) * std::sqrt(-2.0 * std::log(qpl::random(std::numeric_limits<double>::epsilon(), 1.0)));
+		return qpl::random_normal();
 	}
 
 	qpl::f64 qpl::NN2::neural_net::get_accuracy() const {
@@ -603,29 +603,24 @@ namespace qpl {
 	void qpl::NN2::neural_net::randomize_weights_and_biases() {
 		this->accuracy_sum = 0.0;
 		this->generation_ctr = 0u;
-		
 
+		std::vector<qpl::f64> weights;
 		for (qpl::u32 l = 1u; l < this->layers.size(); ++l) {
+			auto deviation = std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
+			weights.resize(this->layers[l - 1].neurons.size());
 
 			for (auto& neuron : this->layers[l].neurons) {
 				neuron.gradient = neuron.output = 0.0;
-				neuron.bias = qpl::NN2::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-				neuron.bias *= 0.2;
-
-				//neuron.bias = qpl::random(-1.0, 1.0);
-
-				neuron.synapses.resize(this->layers[l - 1].neurons.size());
+				neuron.bias = qpl::random_normal(0.0, deviation * 0.2);
 
+				qpl::fill_random_normal(weights, 0.0, deviation);
+				neuron.synapses.resize(weights.size());
 				for (qpl::u32 s = 0u; s < neuron.synapses.size(); ++s) {
 					neuron.synapses[s].delta_weight = 0.0;
-					//neuron.synapses[s].weight = qpl::random(-1.0, 1.0);
-					neuron.synapses[s].weight = qpl::NN2::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-					
+					neuron.synapses[s].weight = weights[s];
 				}
 			}
 		}
-
-
 	}
 	void qpl::NN2::neural_net::observe_test() const {
 		qpl::size l_ctr = 0u;
@@ -739,7 +734,7 @@ namespace qpl {
 		return 1.0 / (1.0 + std::exp(-n));
 	}
 	qpl::f64 qpl::NN3::normal_distribution() {
-		return std::sin(2.0 * qpl::pi * qpl::random(std::numeric_limits<double>::epsilon(), 1.0)) * std::sqrt(-2.0 * std::log(qpl::random(std::numeric_limits<double>::epsilon(), 1.0)));
+		return qpl::random_normal();
 	}
 
 	qpl::f64 qpl::NN3::neural_net::get_accuracy() const {
@@ -768,28 +763,23 @@ namespace qpl {
 		this->accuracy_sum = 0.0;
 		this->generation_ctr = 0u;
 
-
+		std::vector<qpl::f64> weights;
 		for (qpl::u32 l = 1u; l < this->layers.size(); ++l) {
+			auto deviation = std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
+			weights.resize(this->layers[l - 1].neurons.size());
 
 			for (auto& neuron : this->layers[l].neurons) {
 				neuron.gradient = neuron.output = 0.0;
-				neuron.bias = qpl::NN3::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-				neuron.bias *= 0.2;
-
-				//neuron.bias = qpl::random(-1.0, 1.0);
-
-				neuron.synapses.resize(this->layers[l - 1].neurons.size());
+				neuron.bias = qpl::random_normal(0.0, deviation * 0.2);
 
+				qpl::fill_random_normal(weights, 0.0, deviation);
+				neuron.synapses.resize(weights.size());
 				for (qpl::u32 s = 0u; s < neuron.synapses.size(); ++s) {
 					neuron.synapses[s].delta_weight = 0.0;
-					//neuron.synapses[s].weight = qpl::random(-1.0, 1.0);
-					neuron.synapses[s].weight = qpl::NN3::normal_distribution() * std::sqrt(1.0 / (this->layers[l - 1].neurons.size() + 1));
-
+					neuron.synapses[s].weight = weights[s];
 				}
 			}
 		}
-
-
 	}
 	void qpl::NN3::neural_net::observe_test() const {
 		qpl::size l_ctr = 0u;
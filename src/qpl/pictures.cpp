@@ -10,10 +10,10 @@ namespace qpl {
 	}
 
 	void qpl::pixels::load(qpl::string_view sv) {
-		qpl::string_to_vector_memory(sv, this->data);
+		qpl::assign_memory(qpl::as_bytes(sv), this->data);
 	}
 	void qpl::pixels::load_bmp(qpl::string_view sv) {
-		qpl::string_to_vector_memory(sv.substr(64), this->data);
+		qpl::assign_memory(qpl::as_bytes(sv.substr(64)), this->data);
 	}
 	void qpl::pixels::set_dimension(qpl::u32 width, qpl::u32 height) { 
 		this->width = width;
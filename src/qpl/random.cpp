@@ -4,6 +4,22 @@
 namespace qpl {
 	qpl::detail::rng_t qpl::detail::rng;
 
+	qpl::detail::ziggurat_t::ziggurat_t() {
+		auto density = [](qpl::f64 x) {
+			return std::exp(-0.5 * x * x);
+		};
+		this->x[0] = v / density(r);
+		this->x[1] = r;
+		for (qpl::size i = 1u; i < layers - 1; ++i) {
+			this->x[i + 1] = std::sqrt(-2.0 * std::log(v / this->x[i] + density(this->x[i])));
+		}
+		this->x[layers] = 0.0;
+		for (qpl::size i = 0u; i <= layers; ++i) {
+			this->f[i] = density(this->x[i]);
+		}
+	}
+	const qpl::detail::ziggurat_t qpl::detail::ziggurat;
+
 	void qpl::set_random_range_i(qpl::i64 max) {
 		qpl::detail::rng.idist.set_range(max);
 	}
@@ -24,6 +40,7 @@ namespace qpl {
 	}
 	void qpl::set_random_seed(qpl::u64 seed) {
 		qpl::detail::rng.rng.seed(seed);
+		qpl::detail::rng.block.clear();
 	}
 	bool qpl::random_b() {
 		return qpl::detail::rng.rng.generate() & 0x1ull;
@@ -64,6 +81,9 @@ namespace qpl {
 	qpl::u64 qpl::random() {
 		return qpl::detail::rng.rng.generate();
 	}
+	qpl::f64 qpl::random_normal(qpl::f64 mu, qpl::f64 sigma) {
+		return qpl::detail::ziggurat_normal(qpl::detail::rng.block) * sigma + mu;
+	}
 	qpl::f64 qpl::random_falling(qpl::f64 n) {
 		return (1.0 / qpl::random(0.0, 1.0 / n)) - n;
 	}
@@ -417,77 +417,76 @@ namespace qpl {
 		return static_cast<qpl::char_type>(qpl::random_i(32, 126));
 	}
 	std::string qpl::random_string(qpl::size length) {
-		std::ostringstream stream;
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << qpl::random_visible_char();
-		}
-		return stream.str();
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), char{ 32 }, char{ 126 });
+		return result;
 	}
 	std::string qpl::random_number_string(qpl::size length) {
-		std::ostringstream stream;
-		qpl::set_random_range_i('0', '9');
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << static_cast<qpl::char_type>(qpl::random_i());
-		}
-		return stream.str();
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), '0', '9');
+		return result;
 	}
 	std::string qpl::random_lowercase_uppercase_number_string(qpl::size length) {
-		std::ostringstream stream;
-		for (auto i = qpl::size{}; i < length; ++i) {
-			qpl::set_random_range_i('a', 'z');
-			auto c = qpl::random_i();
-			qpl::set_random_range_i('0', '9');
-			auto d = qpl::random_i();
-			stream << static_cast<qpl::char_type>(qpl::random_b() ? d : (qpl::random_b() ? (c - ('a' - 'A')) : c));
+		//half digits, a quarter lowercase and a quarter uppercase: 1040 = 2 * 2 * 10 * 26
+		std::vector<qpl::u16> random(length);
+		qpl::fill_random(random, qpl::u16{ 0 }, qpl::u16{ 1039 });
+
+		std::string result(length, '\0');
+		for (qpl::size i = 0u; i < length; ++i) {
+			auto r = random[i];
+			if (r < 520u) {
+				result[i] = static_cast<char>('0' + r % 10u);
+			}
+			else if (r < 780u) {
+				result[i] = static_cast<char>('A' + (r - 520u) % 26u);
+			}
+			else {
+				result[i] = static_cast<char>('a' + (r - 780u) % 26u);
+			}
 		}
-		return stream.str();
+		return result;
 	}
 	std::string qpl::random_lowercase_number_string(qpl::size length) {
-		std::ostringstream stream;
-		for (auto i = qpl::size{}; i < length; ++i) {
-			qpl::set_random_range_i('a', 'z');
-			auto c = qpl::random_i();
-			qpl::set_random_range_i('0', '9');
-			auto d = qpl::random_i();
-			stream << static_cast<qpl::char_type>(qpl::random_b() ? d : c);
+		//half digits, half lowercase: 520 = 2 * 10 * 26
+		std::vector<qpl::u16> random(length);
+		qpl::fill_random(random, qpl::u16{ 0 }, qpl::u16{ 519 });
+
+		std::string result(length, '\0');
+		for (qpl::size i = 0u; i < length; ++i) {
+			auto r = random[i];
+			result[i] = static_cast<char>(r < 260u ? ('0' + r % 10u) : ('a' + (r - 260u) % 26u));
 		}
-		return stream.str();
+		return result;
 	}
 	std::string qpl::random_uppercase_number_string(qpl::size length) {
-		std::ostringstream stream;
-		for (auto i = qpl::size{}; i < length; ++i) {
-			qpl::set_random_range_i('A', 'Z');
-			auto c = qpl::random_i();
-			qpl::set_random_range_i('0', '9');
-			auto d = qpl::random_i();
-			stream << static_cast<qpl::char_type>(qpl::random_b() ? d : c);
+		//half digits, half uppercase: 520 = 2 * 10 * 26
+		std::vector<qpl::u16> random(length);
+		qpl::fill_random(random, qpl::u16{ 0 }, qpl::u16{ 519 });
+
+		std::string result(length, '\0');
+		for (qpl::size i = 0u; i < length; ++i) {
+			auto r = random[i];
+			result[i] = static_cast<char>(r < 260u ? ('0' + r % 10u) : ('A' + (r - 260u) % 26u));
 		}
-		return stream.str();
+		return result;
 	}
 	std::string qpl::random_lowercase_uppercase_string(qpl::size length) {
-		std::ostringstream stream;
-		qpl::set_random_range_i('a', 'z');
-		for (auto i = qpl::size{}; i < length; ++i) {
-			auto r = qpl::random_i();
-			stream << static_cast<qpl::char_type>(qpl::random_b() ? (r - ('a' - 'A')) : r);
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), char{ 0 }, char{ 51 });
+		for (auto& c : result) {
+			c = static_cast<char>(c < 26 ? ('a' + c) : ('A' + (c - 26)));
 		}
-		return stream.str();
+		return result;
 	}
 	std::string qpl::random_lowercase_string(qpl::size length) {
-		std::ostringstream stream;
-		qpl::set_random_range_i('a', 'z');
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << static_cast<qpl::char_type>(qpl::random_i());
-		}
-		return stream.str();
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), 'a', 'z');
+		return result;
 	}
 	std::string qpl::random_uppercase_string(qpl::size length) {
-		std::ostringstream stream;
-		qpl::set_random_range_i('A', 'Z');
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << static_cast<qpl::char_type>(qpl::random_i());
-		}
-		return stream.str();
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), 'A', 'Z');
+		return result;
 	}
 	std::string qpl::to_lower(const std::string& string) {
 		auto result = string;
@@ -697,21 +696,14 @@ namespace qpl {
 	}
 
 	std::string qpl::random_string_full_range(qpl::size length) {
-		std::ostringstream stream;
-		qpl::set_random_range_i(qpl::type_min<char>(), qpl::type_max<char>());
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << static_cast<qpl::char_type>(qpl::random_i());
-		}
-		return stream.str();
+		std::string result(length, '\0');
+		qpl::fill_random(qpl::span<char>(result.data(), result.size()), qpl::type_min<char>(), qpl::type_max<char>());
+		return result;
 	}
 	std::wstring qpl::random_wstring_full_range(qpl::size length) {
-		std::wostringstream stream;
-		qpl::set_random_range_i(qpl::type_min<wchar_t>(), qpl::type_max<wchar_t>());
-		for (auto i = qpl::size{}; i < length; ++i) {
-			stream << static_cast<qpl::char_type>(qpl::random_i());
-		}
-		return stream.str();
+		std::wstring result(length, L'\0');
+		qpl::fill_random(qpl::span<wchar_t>(result.data(), result.size()), qpl::type_min<wchar_t>(), qpl::type_max<wchar_t>());
+		return result;
 	}
 
-
 }
\ No newline at end of file
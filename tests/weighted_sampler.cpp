@@ -0,0 +1,112 @@
+//standalone distribution check for qpl::weighted_sampler: build against qpl and run, exits with 1 on failure.
+//compares the sample counts of the alias table and the fenwick tree with get_probability() using a chi-square test
+#include <qpl/random.hpp>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr qpl::size samples = 1'000'000u;
+
+	//chi-square statistic over the buckets with non-zero probability. a sample in a zero weight bucket fails directly
+	template<typename T>
+	bool chi_square(const char* name, const qpl::weighted_sampler<T>& sampler, const std::vector<qpl::size>& counts) {
+		qpl::f64 statistic = 0.0;
+		qpl::size degrees = 0u;
+		for (qpl::size i = 0u; i < counts.size(); ++i) {
+			auto expected = sampler.get_probability(i) * samples;
+			if (expected == 0.0) {
+				if (counts[i]) {
+					std::printf("%s: index %zu has weight 0 but was sampled %zu times\n", name, i, counts[i]);
+					return false;
+				}
+				continue;
+			}
+			auto difference = static_cast<qpl::f64>(counts[i]) - expected;
+			statistic += difference * difference / expected;
+			++degrees;
+		}
+		degrees = degrees ? degrees - 1 : 0u;
+
+		//mean + 6 standard deviations of the chi-square distribution, the engine is seeded so this doesn't flake
+		auto limit = degrees + 6.0 * std::sqrt(2.0 * degrees);
+		bool passed = statistic <= limit;
+		std::printf("%s: chi^2 = %.2f (df = %zu, limit %.2f) %s\n", name, statistic, degrees, limit, passed ? "ok" : "FAILED");
+		return passed;
+	}
+
+	template<typename T>
+	bool check(const char* name, qpl::weighted_sampler<T>& sampler) {
+		qpl::random_engine<64> engine;
+		engine.seed(12345u);
+
+		std::vector<qpl::size> table(sampler.size());
+		sampler.rebuild();
+		for (qpl::size i = 0u; i < samples; ++i) {
+			++table[sampler.generate(engine)];
+		}
+		std::vector<qpl::size> tree(sampler.size());
+		for (qpl::size i = 0u; i < samples; ++i) {
+			++tree[sampler.generate_tree(engine)];
+		}
+		bool a = chi_square((std::string(name) + " table").c_str(), sampler, table);
+		bool b = chi_square((std::string(name) + " tree").c_str(), sampler, tree);
+		return a && b;
+	}
+}
+
+int main() {
+	bool passed = true;
+
+	qpl::weighted_sampler<qpl::f64> floats({ 0.5, 2.0, 0.0, 7.25, 1.0, 0.125 });
+	passed &= check("f64", floats);
+
+	//the sum (255 * 64) doesn't fit into the weight type
+	std::vector<qpl::u8> bytes(64, qpl::u8{ 255 });
+	bytes[3] = 1u;
+	bytes[10] = 0u;
+	qpl::weighted_sampler<qpl::u8> narrow(bytes);
+	passed &= check("u8", narrow);
+
+	qpl::weighted_sampler<qpl::i32> integers({ 2'000'000'000, 1'000'000'000, 3, 500'000'000 });
+	passed &= check("i32", integers);
+
+	//fenwick updates, then the rebuilt table
+	qpl::weighted_sampler<qpl::u32> updated({ 1u, 1u, 1u, 1u, 1u, 1u, 1u });
+	updated.set_weight(2u, 10u);
+	updated.add_weight(5u, 4u);
+	updated.set_weight(0u, 0u);
+	passed &= check("u32 updated", updated);
+
+	//all weights zero samples uniformly, from both the table and the tree
+	qpl::weighted_sampler<qpl::f32> zero({ 0.0f, 0.0f, 0.0f, 0.0f });
+	qpl::random_engine<64> engine;
+	engine.seed(1u);
+	std::vector<qpl::size> table(4u), tree(4u);
+	for (qpl::size i = 0u; i < 40'000u; ++i) {
+		++table[zero.generate(engine)];
+		++tree[zero.generate_tree(engine)];
+	}
+	for (qpl::size i = 0u; i < 4u; ++i) {
+		if (table[i] < 9'000u || tree[i] < 9'000u) {
+			std::printf("zero weights: index %zu not uniform (table %zu, tree %zu)\n", i, table[i], tree[i]);
+			passed = false;
+		}
+	}
+
+	bool threw = false;
+	try {
+		qpl::weighted_sampler<qpl::i32> negative({ 1, -1 });
+	}
+	catch (const std::invalid_argument&) {
+		threw = true;
+	}
+	if (!threw) {
+		std::printf("negative weights were accepted\n");
+		passed = false;
+	}
+
+	std::printf(passed ? "all passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}